@@ -0,0 +1,213 @@
+// Auto generated by gen_dispatch.py from tree_rpc.json
+#include "dispatch.hpp"
+#include <string>
+
+namespace tree {
+namespace rpc {
+
+namespace {
+
+[[noreturn]] void bad(const char *where, const char *name, const char *expected) {
+    throw BadArgs(std::string(where) + ": " + name + " must be " + expected);
+}
+
+const msgpack::object *tuple(const nvim::ObjectRef &v, uint32_t n, const char *where) {
+    if (!v.is_array() || v.size() < n)
+        throw BadArgs(std::string(where) + ": expected an array of " + std::to_string(n));
+    return v.object().via.array.ptr;
+}
+
+void get_string(const nvim::ObjectRef &v, boost::string_ref &res, const char *where, const char *name) {
+    if (!v.is_string())
+        bad(where, name, "a String");
+    res = v.as_string_ref();
+}
+
+void get_integer(const nvim::ObjectRef &v, int64_t &res, const char *where, const char *name) {
+    if (v.type() != msgpack::type::POSITIVE_INTEGER && v.type() != msgpack::type::NEGATIVE_INTEGER &&
+            v.type() != msgpack::type::EXT)
+        bad(where, name, "an Integer");
+    res = v.as_int();
+}
+
+void get_boolean(const nvim::ObjectRef &v, bool &res, const char *where, const char *name) {
+    if (v.type() != msgpack::type::BOOLEAN)
+        bad(where, name, "a Boolean");
+    res = v.as_bool();
+}
+
+void get_array(const nvim::ObjectRef &v, nvim::ObjectRef &res, const char *where, const char *name) {
+    if (!v.is_array())
+        bad(where, name, "an Array");
+    res = v;
+}
+
+void get_dictionary(const nvim::ObjectRef &v, nvim::ObjectRef &res, const char *where, const char *name) {
+    if (!v.is_map())
+        bad(where, name, "a Dictionary");
+    res = v;
+}
+
+void get_context(const nvim::ObjectRef &v, nvim::ObjectRef &res, const char *where, const char *name) {
+    if (!v.is_array() && !v.is_map())
+        bad(where, name, "an Array or a Dictionary");
+    res = v;
+}
+
+void get_object(const nvim::ObjectRef &v, nvim::ObjectRef &res, const char *, const char *) {
+    res = v;
+}
+
+const boost::string_ref kRequestNames[] = {
+    "_tree_start",
+    "_tree_get_candidate",
+    "_tree_do_action",
+    "_tree_stats",
+    "_tree_log_level",
+};
+const int8_t kRequestSlots[] = {
+    4, -1, -1, 2, 3, 1, -1, 0,
+};
+
+const boost::string_ref kNotificationNames[] = {
+    "_tree_async_action",
+    "function",
+};
+const int8_t kNotificationSlots[] = {
+    0, 1,
+};
+
+const boost::string_ref kFunctionNames[] = {
+    "paste",
+    "new_file",
+    "rename",
+    "remove",
+    "on_detach",
+};
+const int8_t kFunctionSlots[] = {
+    0, -1, 4, 2, 1, 3, -1, -1,
+};
+
+const boost::string_ref kActionNames[] = {
+    "cd",
+    "goto",
+    "open_or_close_tree",
+    "open",
+    "copy",
+    "move",
+    "paste",
+    "remove",
+    "yank_path",
+    "toggle_select",
+    "toggle_select_all",
+    "print",
+    "debug",
+    "toggle_ignored_files",
+    "redraw",
+    "new_file",
+    "execute_system",
+    "rename",
+    "drop",
+    "call",
+    "view",
+    "open_tree_recursive",
+};
+const int8_t kActionSlots[] = {
+    -1, -1, -1, -1, -1, -1, 13, -1, -1, -1, 18, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 21, -1, -1, -1, 2, -1, -1, -1, -1, -1, -1, 16, -1, -1, -1, -1, -1, 1, -1, 12, -1, 8, -1, -1, 7, -1, -1, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, 14, -1, -1, -1, 9, -1, 11, -1, -1, -1, -1, -1, -1, -1, 5, -1, -1, -1, -1, -1, -1, -1, -1, 19, -1, -1, -1, -1, -1, 17, -1, -1, 10, -1, -1, -1, -1, -1, -1, -1, -1, -1, 20, -1, -1, -1, 4, -1, -1, -1, 6, 3,
+};
+
+} // namespace
+
+Request find_request(boost::string_ref name) {
+    const uint32_t mask = sizeof(kRequestSlots) - 1;
+    int i = kRequestSlots[hash(name, 2u) & mask];
+    return i >= 0 && kRequestNames[i] == name ? static_cast<Request>(i) : Request::kUnknown;
+}
+
+Notification find_notification(boost::string_ref name) {
+    const uint32_t mask = sizeof(kNotificationSlots) - 1;
+    int i = kNotificationSlots[hash(name, 0u) & mask];
+    return i >= 0 && kNotificationNames[i] == name ? static_cast<Notification>(i) : Notification::kUnknown;
+}
+
+Function find_function(boost::string_ref name) {
+    const uint32_t mask = sizeof(kFunctionSlots) - 1;
+    int i = kFunctionSlots[hash(name, 0u) & mask];
+    return i >= 0 && kFunctionNames[i] == name ? static_cast<Function>(i) : Function::kUnknown;
+}
+
+Action find_action(boost::string_ref name) {
+    const uint32_t mask = sizeof(kActionSlots) - 1;
+    int i = kActionSlots[hash(name, 22u) & mask];
+    return i >= 0 && kActionNames[i] == name ? static_cast<Action>(i) : Action::kUnknown;
+}
+
+TreeStartArgs::TreeStartArgs(const nvim::ObjectRef &msg) {
+    const msgpack::object *a0 = tuple(msg, 2, "_tree_start");
+    get_array(a0[0], paths, "_tree_start", "paths");
+    get_dictionary(a0[1], context, "_tree_start", "context");
+}
+
+TreeGetCandidateArgs::TreeGetCandidateArgs(const nvim::ObjectRef &msg) {
+    const msgpack::object *a0 = tuple(msg, 1, "_tree_get_candidate");
+    get_context(a0[0], context, "_tree_get_candidate", "context");
+}
+
+TreeDoActionArgs::TreeDoActionArgs(const nvim::ObjectRef &msg) {
+    const msgpack::object *a0 = tuple(msg, 3, "_tree_do_action");
+    get_string(a0[0], action, "_tree_do_action", "action");
+    get_array(a0[1], args, "_tree_do_action", "args");
+    get_context(a0[2], context, "_tree_do_action", "context");
+}
+
+TreeLogLevelArgs::TreeLogLevelArgs(const nvim::ObjectRef &msg) {
+    const msgpack::object *a0 = tuple(msg, 1, "_tree_log_level");
+    get_string(a0[0], level, "_tree_log_level", "level");
+}
+
+TreeAsyncActionArgs::TreeAsyncActionArgs(const nvim::ObjectRef &msg) {
+    const msgpack::object *a0 = tuple(msg, 3, "_tree_async_action");
+    get_string(a0[0], action, "_tree_async_action", "action");
+    get_array(a0[1], args, "_tree_async_action", "args");
+    get_context(a0[2], context, "_tree_async_action", "context");
+}
+
+FunctionArgs::FunctionArgs(const nvim::ObjectRef &msg) {
+    const msgpack::object *a0 = tuple(msg, 2, "function");
+    get_string(a0[0], name, "function", "name");
+    get_object(a0[1], args, "function", "args");
+}
+
+FunctionPasteArgs::FunctionPasteArgs(const nvim::ObjectRef &msg) {
+    const msgpack::object *a0 = tuple(msg, 3, "paste");
+    const msgpack::object *a1 = tuple(a0[0], 2, "paste.pos");
+    get_integer(a1[0], pos.buf, "paste.pos", "buf");
+    get_integer(a1[1], pos.line, "paste.pos", "line");
+    get_string(a0[1], src, "paste", "src");
+    get_string(a0[2], dest, "paste", "dest");
+}
+
+FunctionNewFileArgs::FunctionNewFileArgs(const nvim::ObjectRef &msg) {
+    const msgpack::object *a0 = tuple(msg, 2, "new_file");
+    get_string(a0[0], input, "new_file", "input");
+    get_integer(a0[1], bufnr, "new_file", "bufnr");
+}
+
+FunctionRenameArgs::FunctionRenameArgs(const nvim::ObjectRef &msg) {
+    const msgpack::object *a0 = tuple(msg, 2, "rename");
+    get_string(a0[0], input, "rename", "input");
+    get_integer(a0[1], bufnr, "rename", "bufnr");
+}
+
+FunctionRemoveArgs::FunctionRemoveArgs(const nvim::ObjectRef &msg) {
+    const msgpack::object *a0 = tuple(msg, 2, "remove");
+    get_integer(a0[0], buf, "remove", "buf");
+    get_integer(a0[1], choice, "remove", "choice");
+}
+
+FunctionOnDetachArgs::FunctionOnDetachArgs(const nvim::ObjectRef &msg) {
+    get_integer(msg, buf, "on_detach", "buf");
+}
+
+} //namespace rpc
+} //namespace tree
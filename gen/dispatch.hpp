@@ -0,0 +1,203 @@
+// Auto generated by gen_dispatch.py from tree_rpc.json
+
+#ifndef NEOVIM_CPP__DISPATCH_HPP
+#define NEOVIM_CPP__DISPATCH_HPP
+
+#include <cstdint>
+#include <stdexcept>
+#include <boost/utility/string_ref.hpp>
+
+#include "object_ref.hpp"
+
+namespace tree {
+namespace rpc {
+
+/// Thrown by the decoders, what() names the message and the argument.
+class BadArgs : public std::invalid_argument {
+public:
+    using std::invalid_argument::invalid_argument;
+};
+
+/// FNV-1a, the tables below are perfect hashes of it.
+inline uint32_t hash(boost::string_ref s, uint32_t seed) {
+    uint32_t h = 2166136261u ^ seed;
+    for (char c : s) {
+        h ^= static_cast<unsigned char>(c);
+        h *= 16777619u;
+    }
+    return h;
+}
+
+enum class Request {
+    kTreeStart,
+    kTreeGetCandidate,
+    kTreeDoAction,
+    kTreeStats,
+    kTreeLogLevel,
+    kUnknown
+};
+/// kUnknown if there is no such name, no allocation either way.
+Request find_request(boost::string_ref name);
+
+enum class Notification {
+    kTreeAsyncAction,
+    kFunction,
+    kUnknown
+};
+/// kUnknown if there is no such name, no allocation either way.
+Notification find_notification(boost::string_ref name);
+
+enum class Function {
+    kPaste,
+    kNewFile,
+    kRename,
+    kRemove,
+    kOnDetach,
+    kUnknown
+};
+/// kUnknown if there is no such name, no allocation either way.
+Function find_function(boost::string_ref name);
+
+enum class Action {
+    kCd,
+    kGoto,
+    kOpenOrCloseTree,
+    kOpen,
+    kCopy,
+    kMove,
+    kPaste,
+    kRemove,
+    kYankPath,
+    kToggleSelect,
+    kToggleSelectAll,
+    kPrint,
+    kDebug,
+    kToggleIgnoredFiles,
+    kRedraw,
+    kNewFile,
+    kExecuteSystem,
+    kRename,
+    kDrop,
+    kCall,
+    kView,
+    kOpenTreeRecursive,
+    kUnknown
+};
+/// kUnknown if there is no such name, no allocation either way.
+Action find_action(boost::string_ref name);
+
+// X(id, member) of every Action, member being the Tree method running it.
+#define TREE_ACTIONS(X) \
+    X(kCd, cd) \
+    X(kGoto, goto_) \
+    X(kOpenOrCloseTree, open_tree) \
+    X(kOpen, open) \
+    X(kCopy, copy_) \
+    X(kMove, move) \
+    X(kPaste, pre_paste) \
+    X(kRemove, pre_remove) \
+    X(kYankPath, yank_path) \
+    X(kToggleSelect, toggle_select) \
+    X(kToggleSelectAll, toggle_select_all) \
+    X(kPrint, print) \
+    X(kDebug, debug) \
+    X(kToggleIgnoredFiles, toggle_ignored_files) \
+    X(kRedraw, redraw) \
+    X(kNewFile, new_file) \
+    X(kExecuteSystem, execute_system) \
+    X(kRename, rename) \
+    X(kDrop, drop) \
+    X(kCall, call) \
+    X(kView, view) \
+    X(kOpenTreeRecursive, open_or_close_tree_recursively)
+
+// Arguments, views into the received message. The constructors decode
+// them in one pass and throw BadArgs on a wrong count or type.
+
+// _tree_start [paths, context]
+// Answered at once. A new tree is shown when its directory scan is
+// done, or first from its session_file snapshot. Until then it is
+// not known to the other requests, which fail with BadArgs.
+struct TreeStartArgs {
+    explicit TreeStartArgs(const nvim::ObjectRef &msg);
+    nvim::ObjectRef paths;
+    nvim::ObjectRef context;
+};
+
+// _tree_get_candidate [context]
+struct TreeGetCandidateArgs {
+    explicit TreeGetCandidateArgs(const nvim::ObjectRef &msg);
+    nvim::ObjectRef context;
+};
+
+// _tree_do_action [action, args, context]
+struct TreeDoActionArgs {
+    explicit TreeDoActionArgs(const nvim::ObjectRef &msg);
+    boost::string_ref action;
+    nvim::ObjectRef args;
+    nvim::ObjectRef context;
+};
+
+// _tree_log_level [level]
+struct TreeLogLevelArgs {
+    explicit TreeLogLevelArgs(const nvim::ObjectRef &msg);
+    boost::string_ref level;
+};
+
+// _tree_async_action [action, args, context]
+struct TreeAsyncActionArgs {
+    explicit TreeAsyncActionArgs(const nvim::ObjectRef &msg);
+    boost::string_ref action;
+    nvim::ObjectRef args;
+    nvim::ObjectRef context;
+};
+
+// function [name, args]
+struct FunctionArgs {
+    explicit FunctionArgs(const nvim::ObjectRef &msg);
+    boost::string_ref name;
+    nvim::ObjectRef args;
+};
+
+// paste [pos, src, dest]
+struct FunctionPasteArgs {
+    explicit FunctionPasteArgs(const nvim::ObjectRef &msg);
+    struct Pos {
+        int64_t buf;
+        int64_t line;
+    } pos;
+    boost::string_ref src;
+    boost::string_ref dest;
+};
+
+// new_file [input, bufnr]
+struct FunctionNewFileArgs {
+    explicit FunctionNewFileArgs(const nvim::ObjectRef &msg);
+    boost::string_ref input;
+    int64_t bufnr;
+};
+
+// rename [input, bufnr]
+struct FunctionRenameArgs {
+    explicit FunctionRenameArgs(const nvim::ObjectRef &msg);
+    boost::string_ref input;
+    int64_t bufnr;
+};
+
+// remove [buf, choice]
+struct FunctionRemoveArgs {
+    explicit FunctionRemoveArgs(const nvim::ObjectRef &msg);
+    int64_t buf;
+    int64_t choice;
+};
+
+// on_detach buf
+struct FunctionOnDetachArgs {
+    explicit FunctionOnDetachArgs(const nvim::ObjectRef &msg);
+    int64_t buf;
+};
+
+} //namespace rpc
+} //namespace tree
+
+#endif //NEOVIM_CPP__DISPATCH_HPP
@@ -4,6 +4,179 @@
 
 namespace nvim {
 
+namespace {
+// Pre-encoded method names, see Method.
+constexpr Method kBufLineCount{"nvim_buf_line_count", "\xb3" "nvim_buf_line_count", 20};
+constexpr Method kBufAttach{"nvim_buf_attach", "\xaf" "nvim_buf_attach", 16};
+constexpr Method kBufDetach{"nvim_buf_detach", "\xaf" "nvim_buf_detach", 16};
+constexpr Method kBufGetLines{"nvim_buf_get_lines", "\xb2" "nvim_buf_get_lines", 19};
+constexpr Method kBufSetLines{"nvim_buf_set_lines", "\xb2" "nvim_buf_set_lines", 19};
+constexpr Method kBufGetOffset{"nvim_buf_get_offset", "\xb3" "nvim_buf_get_offset", 20};
+constexpr Method kBufGetVar{"nvim_buf_get_var", "\xb0" "nvim_buf_get_var", 17};
+constexpr Method kBufGetChangedtick{"nvim_buf_get_changedtick", "\xb8" "nvim_buf_get_changedtick", 25};
+constexpr Method kBufGetKeymap{"nvim_buf_get_keymap", "\xb3" "nvim_buf_get_keymap", 20};
+constexpr Method kBufSetKeymap{"nvim_buf_set_keymap", "\xb3" "nvim_buf_set_keymap", 20};
+constexpr Method kBufDelKeymap{"nvim_buf_del_keymap", "\xb3" "nvim_buf_del_keymap", 20};
+constexpr Method kBufGetCommands{"nvim_buf_get_commands", "\xb5" "nvim_buf_get_commands", 22};
+constexpr Method kBufSetVar{"nvim_buf_set_var", "\xb0" "nvim_buf_set_var", 17};
+constexpr Method kBufDelVar{"nvim_buf_del_var", "\xb0" "nvim_buf_del_var", 17};
+constexpr Method kBufGetOption{"nvim_buf_get_option", "\xb3" "nvim_buf_get_option", 20};
+constexpr Method kBufSetOption{"nvim_buf_set_option", "\xb3" "nvim_buf_set_option", 20};
+constexpr Method kBufGetName{"nvim_buf_get_name", "\xb1" "nvim_buf_get_name", 18};
+constexpr Method kBufSetName{"nvim_buf_set_name", "\xb1" "nvim_buf_set_name", 18};
+constexpr Method kBufIsLoaded{"nvim_buf_is_loaded", "\xb2" "nvim_buf_is_loaded", 19};
+constexpr Method kBufIsValid{"nvim_buf_is_valid", "\xb1" "nvim_buf_is_valid", 18};
+constexpr Method kBufGetMark{"nvim_buf_get_mark", "\xb1" "nvim_buf_get_mark", 18};
+constexpr Method kBufAddHighlight{"nvim_buf_add_highlight", "\xb6" "nvim_buf_add_highlight", 23};
+constexpr Method kBufClearNamespace{"nvim_buf_clear_namespace", "\xb8" "nvim_buf_clear_namespace", 25};
+constexpr Method kBufClearHighlight{"nvim_buf_clear_highlight", "\xb8" "nvim_buf_clear_highlight", 25};
+constexpr Method kBufSetVirtualText{"nvim_buf_set_virtual_text", "\xb9" "nvim_buf_set_virtual_text", 26};
+constexpr Method kTabpageListWins{"nvim_tabpage_list_wins", "\xb6" "nvim_tabpage_list_wins", 23};
+constexpr Method kTabpageGetVar{"nvim_tabpage_get_var", "\xb4" "nvim_tabpage_get_var", 21};
+constexpr Method kTabpageSetVar{"nvim_tabpage_set_var", "\xb4" "nvim_tabpage_set_var", 21};
+constexpr Method kTabpageDelVar{"nvim_tabpage_del_var", "\xb4" "nvim_tabpage_del_var", 21};
+constexpr Method kTabpageGetWin{"nvim_tabpage_get_win", "\xb4" "nvim_tabpage_get_win", 21};
+constexpr Method kTabpageGetNumber{"nvim_tabpage_get_number", "\xb7" "nvim_tabpage_get_number", 24};
+constexpr Method kTabpageIsValid{"nvim_tabpage_is_valid", "\xb5" "nvim_tabpage_is_valid", 22};
+constexpr Method kUiAttach{"nvim_ui_attach", "\xae" "nvim_ui_attach", 15};
+constexpr Method kUiDetach{"nvim_ui_detach", "\xae" "nvim_ui_detach", 15};
+constexpr Method kUiTryResize{"nvim_ui_try_resize", "\xb2" "nvim_ui_try_resize", 19};
+constexpr Method kUiSetOption{"nvim_ui_set_option", "\xb2" "nvim_ui_set_option", 19};
+constexpr Method kUiTryResizeGrid{"nvim_ui_try_resize_grid", "\xb7" "nvim_ui_try_resize_grid", 24};
+constexpr Method kUiPumSetHeight{"nvim_ui_pum_set_height", "\xb6" "nvim_ui_pum_set_height", 23};
+constexpr Method kCommand{"nvim_command", "\xac" "nvim_command", 13};
+constexpr Method kGetHlByName{"nvim_get_hl_by_name", "\xb3" "nvim_get_hl_by_name", 20};
+constexpr Method kGetHlById{"nvim_get_hl_by_id", "\xb1" "nvim_get_hl_by_id", 18};
+constexpr Method kFeedkeys{"nvim_feedkeys", "\xad" "nvim_feedkeys", 14};
+constexpr Method kInput{"nvim_input", "\xaa" "nvim_input", 11};
+constexpr Method kInputMouse{"nvim_input_mouse", "\xb0" "nvim_input_mouse", 17};
+constexpr Method kReplaceTermcodes{"nvim_replace_termcodes", "\xb6" "nvim_replace_termcodes", 23};
+constexpr Method kCommandOutput{"nvim_command_output", "\xb3" "nvim_command_output", 20};
+constexpr Method kEval{"nvim_eval", "\xa9" "nvim_eval", 10};
+constexpr Method kExecuteLua{"nvim_execute_lua", "\xb0" "nvim_execute_lua", 17};
+constexpr Method kCallFunction{"nvim_call_function", "\xb2" "nvim_call_function", 19};
+constexpr Method kCallDictFunction{"nvim_call_dict_function", "\xb7" "nvim_call_dict_function", 24};
+constexpr Method kStrwidth{"nvim_strwidth", "\xad" "nvim_strwidth", 14};
+constexpr Method kListRuntimePaths{"nvim_list_runtime_paths", "\xb7" "nvim_list_runtime_paths", 24};
+constexpr Method kSetCurrentDir{"nvim_set_current_dir", "\xb4" "nvim_set_current_dir", 21};
+constexpr Method kGetCurrentLine{"nvim_get_current_line", "\xb5" "nvim_get_current_line", 22};
+constexpr Method kSetCurrentLine{"nvim_set_current_line", "\xb5" "nvim_set_current_line", 22};
+constexpr Method kDelCurrentLine{"nvim_del_current_line", "\xb5" "nvim_del_current_line", 22};
+constexpr Method kGetVar{"nvim_get_var", "\xac" "nvim_get_var", 13};
+constexpr Method kSetVar{"nvim_set_var", "\xac" "nvim_set_var", 13};
+constexpr Method kDelVar{"nvim_del_var", "\xac" "nvim_del_var", 13};
+constexpr Method kGetVvar{"nvim_get_vvar", "\xad" "nvim_get_vvar", 14};
+constexpr Method kSetVvar{"nvim_set_vvar", "\xad" "nvim_set_vvar", 14};
+constexpr Method kGetOption{"nvim_get_option", "\xaf" "nvim_get_option", 16};
+constexpr Method kSetOption{"nvim_set_option", "\xaf" "nvim_set_option", 16};
+constexpr Method kOutWrite{"nvim_out_write", "\xae" "nvim_out_write", 15};
+constexpr Method kErrWrite{"nvim_err_write", "\xae" "nvim_err_write", 15};
+constexpr Method kErrWriteln{"nvim_err_writeln", "\xb0" "nvim_err_writeln", 17};
+constexpr Method kListBufs{"nvim_list_bufs", "\xae" "nvim_list_bufs", 15};
+constexpr Method kGetCurrentBuf{"nvim_get_current_buf", "\xb4" "nvim_get_current_buf", 21};
+constexpr Method kSetCurrentBuf{"nvim_set_current_buf", "\xb4" "nvim_set_current_buf", 21};
+constexpr Method kListWins{"nvim_list_wins", "\xae" "nvim_list_wins", 15};
+constexpr Method kGetCurrentWin{"nvim_get_current_win", "\xb4" "nvim_get_current_win", 21};
+constexpr Method kSetCurrentWin{"nvim_set_current_win", "\xb4" "nvim_set_current_win", 21};
+constexpr Method kCreateBuf{"nvim_create_buf", "\xaf" "nvim_create_buf", 16};
+constexpr Method kOpenWin{"nvim_open_win", "\xad" "nvim_open_win", 14};
+constexpr Method kListTabpages{"nvim_list_tabpages", "\xb2" "nvim_list_tabpages", 19};
+constexpr Method kGetCurrentTabpage{"nvim_get_current_tabpage", "\xb8" "nvim_get_current_tabpage", 25};
+constexpr Method kSetCurrentTabpage{"nvim_set_current_tabpage", "\xb8" "nvim_set_current_tabpage", 25};
+constexpr Method kCreateNamespace{"nvim_create_namespace", "\xb5" "nvim_create_namespace", 22};
+constexpr Method kGetNamespaces{"nvim_get_namespaces", "\xb3" "nvim_get_namespaces", 20};
+constexpr Method kPaste{"nvim_paste", "\xaa" "nvim_paste", 11};
+constexpr Method kPut{"nvim_put", "\xa8" "nvim_put", 9};
+constexpr Method kSubscribe{"nvim_subscribe", "\xae" "nvim_subscribe", 15};
+constexpr Method kUnsubscribe{"nvim_unsubscribe", "\xb0" "nvim_unsubscribe", 17};
+constexpr Method kGetColorByName{"nvim_get_color_by_name", "\xb6" "nvim_get_color_by_name", 23};
+constexpr Method kGetColorMap{"nvim_get_color_map", "\xb2" "nvim_get_color_map", 19};
+constexpr Method kGetContext{"nvim_get_context", "\xb0" "nvim_get_context", 17};
+constexpr Method kLoadContext{"nvim_load_context", "\xb1" "nvim_load_context", 18};
+constexpr Method kGetMode{"nvim_get_mode", "\xad" "nvim_get_mode", 14};
+constexpr Method kGetKeymap{"nvim_get_keymap", "\xaf" "nvim_get_keymap", 16};
+constexpr Method kSetKeymap{"nvim_set_keymap", "\xaf" "nvim_set_keymap", 16};
+constexpr Method kDelKeymap{"nvim_del_keymap", "\xaf" "nvim_del_keymap", 16};
+constexpr Method kGetCommands{"nvim_get_commands", "\xb1" "nvim_get_commands", 18};
+constexpr Method kGetApiInfo{"nvim_get_api_info", "\xb1" "nvim_get_api_info", 18};
+constexpr Method kSetClientInfo{"nvim_set_client_info", "\xb4" "nvim_set_client_info", 21};
+constexpr Method kGetChanInfo{"nvim_get_chan_info", "\xb2" "nvim_get_chan_info", 19};
+constexpr Method kListChans{"nvim_list_chans", "\xaf" "nvim_list_chans", 16};
+constexpr Method kCallAtomic{"nvim_call_atomic", "\xb0" "nvim_call_atomic", 17};
+constexpr Method kParseExpression{"nvim_parse_expression", "\xb5" "nvim_parse_expression", 22};
+constexpr Method kListUis{"nvim_list_uis", "\xad" "nvim_list_uis", 14};
+constexpr Method kGetProcChildren{"nvim_get_proc_children", "\xb6" "nvim_get_proc_children", 23};
+constexpr Method kGetProc{"nvim_get_proc", "\xad" "nvim_get_proc", 14};
+constexpr Method kSelectPopupmenuItem{"nvim_select_popupmenu_item", "\xba" "nvim_select_popupmenu_item", 27};
+constexpr Method kWinGetBuf{"nvim_win_get_buf", "\xb0" "nvim_win_get_buf", 17};
+constexpr Method kWinSetBuf{"nvim_win_set_buf", "\xb0" "nvim_win_set_buf", 17};
+constexpr Method kWinGetCursor{"nvim_win_get_cursor", "\xb3" "nvim_win_get_cursor", 20};
+constexpr Method kWinSetCursor{"nvim_win_set_cursor", "\xb3" "nvim_win_set_cursor", 20};
+constexpr Method kWinGetHeight{"nvim_win_get_height", "\xb3" "nvim_win_get_height", 20};
+constexpr Method kWinSetHeight{"nvim_win_set_height", "\xb3" "nvim_win_set_height", 20};
+constexpr Method kWinGetWidth{"nvim_win_get_width", "\xb2" "nvim_win_get_width", 19};
+constexpr Method kWinSetWidth{"nvim_win_set_width", "\xb2" "nvim_win_set_width", 19};
+constexpr Method kWinGetVar{"nvim_win_get_var", "\xb0" "nvim_win_get_var", 17};
+constexpr Method kWinSetVar{"nvim_win_set_var", "\xb0" "nvim_win_set_var", 17};
+constexpr Method kWinDelVar{"nvim_win_del_var", "\xb0" "nvim_win_del_var", 17};
+constexpr Method kWinGetOption{"nvim_win_get_option", "\xb3" "nvim_win_get_option", 20};
+constexpr Method kWinSetOption{"nvim_win_set_option", "\xb3" "nvim_win_set_option", 20};
+constexpr Method kWinGetPosition{"nvim_win_get_position", "\xb5" "nvim_win_get_position", 22};
+constexpr Method kWinGetTabpage{"nvim_win_get_tabpage", "\xb4" "nvim_win_get_tabpage", 21};
+constexpr Method kWinGetNumber{"nvim_win_get_number", "\xb3" "nvim_win_get_number", 20};
+constexpr Method kWinIsValid{"nvim_win_is_valid", "\xb1" "nvim_win_is_valid", 18};
+constexpr Method kWinSetConfig{"nvim_win_set_config", "\xb3" "nvim_win_set_config", 20};
+constexpr Method kWinGetConfig{"nvim_win_get_config", "\xb3" "nvim_win_get_config", 20};
+constexpr Method kWinClose{"nvim_win_close", "\xae" "nvim_win_close", 15};
+
+// Response decoders, one per return type, see Decoder.
+void decodeInteger(const msgpack::object &obj, Integer &res) {
+    detail::decode_integer(obj, res);
+}
+void decodeBoolean(const msgpack::object &obj, bool &res) {
+    detail::decode_bool(obj, res);
+}
+void decodeString(const msgpack::object &obj, std::string &res) {
+    detail::decode_string(obj, res);
+}
+void decodeArrayOfString(const msgpack::object &obj, std::vector<std::string> &res) {
+    detail::decode_array(obj, res, decodeString);
+}
+void decodeObject(const msgpack::object &obj, Object &res) {
+    obj.convert(res);
+}
+void decodeDictionary(const msgpack::object &obj, Dictionary &res) {
+    obj.convert(res);
+}
+void decodeArrayOfDictionary(const msgpack::object &obj, std::vector<Dictionary> &res) {
+    detail::decode_array(obj, res, decodeDictionary);
+}
+void decodeArrayOfInteger2(const msgpack::object &obj, std::vector<Integer> &res) {
+    detail::decode_array(obj, res, decodeInteger);
+}
+void decodeWindow(const msgpack::object &obj, Window &res) {
+    detail::decode_handle(obj, 1, res);
+}
+void decodeArrayOfWindow(const msgpack::object &obj, std::vector<Window> &res) {
+    detail::decode_array(obj, res, decodeWindow);
+}
+void decodeBuffer(const msgpack::object &obj, Buffer &res) {
+    detail::decode_handle(obj, 0, res);
+}
+void decodeArrayOfBuffer(const msgpack::object &obj, std::vector<Buffer> &res) {
+    detail::decode_array(obj, res, decodeBuffer);
+}
+void decodeTabpage(const msgpack::object &obj, Tabpage &res) {
+    detail::decode_handle(obj, 2, res);
+}
+void decodeArrayOfTabpage(const msgpack::object &obj, std::vector<Tabpage> &res) {
+    detail::decode_array(obj, res, decodeTabpage);
+}
+void decodeArray(const msgpack::object &obj, Array &res) {
+    obj.convert(res);
+}
+}
+
 void Nvim::connect_tcp(const std::string &host,
         const std::string &service, double timeout_sec) {
     client_.connect_tcp(host, service, timeout_sec);
@@ -14,1129 +187,2121 @@ void Nvim::connect_pipe(const std::string &name,
     client_.connect_pipe(name, timeout_sec);
 }
 
+void Nvim::connect_stdio() {
+    client_.connect_stdio();
+}
+
+void Nvim::connect_fd(int fd) {
+    client_.connect_fd(fd);
+}
+
+Nvim::Batch Nvim::batch() {
+    return Batch(&client_);
+}
+
 
 Integer Nvim::buf_line_count(Buffer buffer) {
-    Integer res;
-    client_.call("nvim_buf_line_count", res, buffer);
+    Integer res{};
+    client_.call(kBufLineCount, res, decodeInteger, buffer);
     return res;
 }
 
 bool Nvim::buf_attach(Buffer buffer, bool send_buffer, const Dictionary& opts) {
-    bool res;
-    client_.call("nvim_buf_attach", res, buffer, send_buffer, opts);
+    bool res{};
+    client_.call(kBufAttach, res, decodeBoolean, buffer, send_buffer, opts);
     return res;
 }
 
 bool Nvim::buf_detach(Buffer buffer) {
-    bool res;
-    client_.call("nvim_buf_detach", res, buffer);
+    bool res{};
+    client_.call(kBufDetach, res, decodeBoolean, buffer);
     return res;
 }
 
 std::vector<std::string> Nvim::buf_get_lines(Buffer buffer, Integer start, Integer end, bool strict_indexing) {
-    std::vector<std::string> res;
-    client_.call("nvim_buf_get_lines", res, buffer, start, end, strict_indexing);
+    std::vector<std::string> res{};
+    client_.call(kBufGetLines, res, decodeArrayOfString, buffer, start, end, strict_indexing);
     return res;
 }
 
 void Nvim::buf_set_lines(Buffer buffer, Integer start, Integer end, bool strict_indexing, const std::vector<std::string>& replacement) {
-    client_.call("nvim_buf_set_lines", nullptr, buffer, start, end, strict_indexing, replacement);
+    client_.call(kBufSetLines, nullptr, buffer, start, end, strict_indexing, replacement);
 }
 
 Integer Nvim::buf_get_offset(Buffer buffer, Integer index) {
-    Integer res;
-    client_.call("nvim_buf_get_offset", res, buffer, index);
+    Integer res{};
+    client_.call(kBufGetOffset, res, decodeInteger, buffer, index);
     return res;
 }
 
 Object Nvim::buf_get_var(Buffer buffer, const std::string& name) {
-    Object res;
-    client_.call("nvim_buf_get_var", res, buffer, name);
+    Object res{};
+    client_.call(kBufGetVar, res, decodeObject, buffer, name);
     return res;
 }
 
 Integer Nvim::buf_get_changedtick(Buffer buffer) {
-    Integer res;
-    client_.call("nvim_buf_get_changedtick", res, buffer);
+    Integer res{};
+    client_.call(kBufGetChangedtick, res, decodeInteger, buffer);
     return res;
 }
 
 std::vector<Dictionary> Nvim::buf_get_keymap(Buffer buffer, const std::string& mode) {
-    std::vector<Dictionary> res;
-    client_.call("nvim_buf_get_keymap", res, buffer, mode);
+    std::vector<Dictionary> res{};
+    client_.call(kBufGetKeymap, res, decodeArrayOfDictionary, buffer, mode);
     return res;
 }
 
 void Nvim::buf_set_keymap(Buffer buffer, const std::string& mode, const std::string& lhs, const std::string& rhs, const Dictionary& opts) {
-    client_.call("nvim_buf_set_keymap", nullptr, buffer, mode, lhs, rhs, opts);
+    client_.call(kBufSetKeymap, nullptr, buffer, mode, lhs, rhs, opts);
 }
 
 void Nvim::buf_del_keymap(Buffer buffer, const std::string& mode, const std::string& lhs) {
-    client_.call("nvim_buf_del_keymap", nullptr, buffer, mode, lhs);
+    client_.call(kBufDelKeymap, nullptr, buffer, mode, lhs);
 }
 
 Dictionary Nvim::buf_get_commands(Buffer buffer, const Dictionary& opts) {
-    Dictionary res;
-    client_.call("nvim_buf_get_commands", res, buffer, opts);
+    Dictionary res{};
+    client_.call(kBufGetCommands, res, decodeDictionary, buffer, opts);
     return res;
 }
 
 void Nvim::buf_set_var(Buffer buffer, const std::string& name, const Object& value) {
-    client_.call("nvim_buf_set_var", nullptr, buffer, name, value);
+    client_.call(kBufSetVar, nullptr, buffer, name, value);
 }
 
 void Nvim::buf_del_var(Buffer buffer, const std::string& name) {
-    client_.call("nvim_buf_del_var", nullptr, buffer, name);
+    client_.call(kBufDelVar, nullptr, buffer, name);
 }
 
 Object Nvim::buf_get_option(Buffer buffer, const std::string& name) {
-    Object res;
-    client_.call("nvim_buf_get_option", res, buffer, name);
+    Object res{};
+    client_.call(kBufGetOption, res, decodeObject, buffer, name);
     return res;
 }
 
 void Nvim::buf_set_option(Buffer buffer, const std::string& name, const Object& value) {
-    client_.call("nvim_buf_set_option", nullptr, buffer, name, value);
+    client_.call(kBufSetOption, nullptr, buffer, name, value);
 }
 
 std::string Nvim::buf_get_name(Buffer buffer) {
-    std::string res;
-    client_.call("nvim_buf_get_name", res, buffer);
+    std::string res{};
+    client_.call(kBufGetName, res, decodeString, buffer);
     return res;
 }
 
 void Nvim::buf_set_name(Buffer buffer, const std::string& name) {
-    client_.call("nvim_buf_set_name", nullptr, buffer, name);
+    client_.call(kBufSetName, nullptr, buffer, name);
 }
 
 bool Nvim::buf_is_loaded(Buffer buffer) {
-    bool res;
-    client_.call("nvim_buf_is_loaded", res, buffer);
+    bool res{};
+    client_.call(kBufIsLoaded, res, decodeBoolean, buffer);
     return res;
 }
 
 bool Nvim::buf_is_valid(Buffer buffer) {
-    bool res;
-    client_.call("nvim_buf_is_valid", res, buffer);
+    bool res{};
+    client_.call(kBufIsValid, res, decodeBoolean, buffer);
     return res;
 }
 
 std::vector<Integer> Nvim::buf_get_mark(Buffer buffer, const std::string& name) {
-    std::vector<Integer> res;
-    client_.call("nvim_buf_get_mark", res, buffer, name);
+    std::vector<Integer> res{};
+    client_.call(kBufGetMark, res, decodeArrayOfInteger2, buffer, name);
     return res;
 }
 
 Integer Nvim::buf_add_highlight(Buffer buffer, Integer ns_id, const std::string& hl_group, Integer line, Integer col_start, Integer col_end) {
-    Integer res;
-    client_.call("nvim_buf_add_highlight", res, buffer, ns_id, hl_group, line, col_start, col_end);
+    Integer res{};
+    client_.call(kBufAddHighlight, res, decodeInteger, buffer, ns_id, hl_group, line, col_start, col_end);
     return res;
 }
 
 void Nvim::buf_clear_namespace(Buffer buffer, Integer ns_id, Integer line_start, Integer line_end) {
-    client_.call("nvim_buf_clear_namespace", nullptr, buffer, ns_id, line_start, line_end);
+    client_.call(kBufClearNamespace, nullptr, buffer, ns_id, line_start, line_end);
 }
 
 void Nvim::buf_clear_highlight(Buffer buffer, Integer ns_id, Integer line_start, Integer line_end) {
-    client_.call("nvim_buf_clear_highlight", nullptr, buffer, ns_id, line_start, line_end);
+    client_.call(kBufClearHighlight, nullptr, buffer, ns_id, line_start, line_end);
 }
 
 Integer Nvim::buf_set_virtual_text(Buffer buffer, Integer ns_id, Integer line, const Array& chunks, const Dictionary& opts) {
-    Integer res;
-    client_.call("nvim_buf_set_virtual_text", res, buffer, ns_id, line, chunks, opts);
+    Integer res{};
+    client_.call(kBufSetVirtualText, res, decodeInteger, buffer, ns_id, line, chunks, opts);
     return res;
 }
 
 std::vector<Window> Nvim::tabpage_list_wins(Tabpage tabpage) {
-    std::vector<Window> res;
-    client_.call("nvim_tabpage_list_wins", res, tabpage);
+    std::vector<Window> res{};
+    client_.call(kTabpageListWins, res, decodeArrayOfWindow, tabpage);
     return res;
 }
 
 Object Nvim::tabpage_get_var(Tabpage tabpage, const std::string& name) {
-    Object res;
-    client_.call("nvim_tabpage_get_var", res, tabpage, name);
+    Object res{};
+    client_.call(kTabpageGetVar, res, decodeObject, tabpage, name);
     return res;
 }
 
 void Nvim::tabpage_set_var(Tabpage tabpage, const std::string& name, const Object& value) {
-    client_.call("nvim_tabpage_set_var", nullptr, tabpage, name, value);
+    client_.call(kTabpageSetVar, nullptr, tabpage, name, value);
 }
 
 void Nvim::tabpage_del_var(Tabpage tabpage, const std::string& name) {
-    client_.call("nvim_tabpage_del_var", nullptr, tabpage, name);
+    client_.call(kTabpageDelVar, nullptr, tabpage, name);
 }
 
 Window Nvim::tabpage_get_win(Tabpage tabpage) {
-    Window res;
-    client_.call("nvim_tabpage_get_win", res, tabpage);
+    Window res{};
+    client_.call(kTabpageGetWin, res, decodeWindow, tabpage);
     return res;
 }
 
 Integer Nvim::tabpage_get_number(Tabpage tabpage) {
-    Integer res;
-    client_.call("nvim_tabpage_get_number", res, tabpage);
+    Integer res{};
+    client_.call(kTabpageGetNumber, res, decodeInteger, tabpage);
     return res;
 }
 
 bool Nvim::tabpage_is_valid(Tabpage tabpage) {
-    bool res;
-    client_.call("nvim_tabpage_is_valid", res, tabpage);
+    bool res{};
+    client_.call(kTabpageIsValid, res, decodeBoolean, tabpage);
     return res;
 }
 
 void Nvim::ui_attach(Integer width, Integer height, const Dictionary& options) {
-    client_.call("nvim_ui_attach", nullptr, width, height, options);
+    client_.call(kUiAttach, nullptr, width, height, options);
 }
 
 void Nvim::ui_detach() {
-    client_.call("nvim_ui_detach", nullptr);
+    client_.call(kUiDetach, nullptr);
 }
 
 void Nvim::ui_try_resize(Integer width, Integer height) {
-    client_.call("nvim_ui_try_resize", nullptr, width, height);
+    client_.call(kUiTryResize, nullptr, width, height);
 }
 
 void Nvim::ui_set_option(const std::string& name, const Object& value) {
-    client_.call("nvim_ui_set_option", nullptr, name, value);
+    client_.call(kUiSetOption, nullptr, name, value);
 }
 
 void Nvim::ui_try_resize_grid(Integer grid, Integer width, Integer height) {
-    client_.call("nvim_ui_try_resize_grid", nullptr, grid, width, height);
+    client_.call(kUiTryResizeGrid, nullptr, grid, width, height);
 }
 
 void Nvim::ui_pum_set_height(Integer height) {
-    client_.call("nvim_ui_pum_set_height", nullptr, height);
+    client_.call(kUiPumSetHeight, nullptr, height);
 }
 
 void Nvim::command(const std::string& command) {
-    client_.call("nvim_command", nullptr, command);
+    client_.call(kCommand, nullptr, command);
 }
 
 Dictionary Nvim::get_hl_by_name(const std::string& name, bool rgb) {
-    Dictionary res;
-    client_.call("nvim_get_hl_by_name", res, name, rgb);
+    Dictionary res{};
+    client_.call(kGetHlByName, res, decodeDictionary, name, rgb);
     return res;
 }
 
 Dictionary Nvim::get_hl_by_id(Integer hl_id, bool rgb) {
-    Dictionary res;
-    client_.call("nvim_get_hl_by_id", res, hl_id, rgb);
+    Dictionary res{};
+    client_.call(kGetHlById, res, decodeDictionary, hl_id, rgb);
     return res;
 }
 
 void Nvim::feedkeys(const std::string& keys, const std::string& mode, bool escape_csi) {
-    client_.call("nvim_feedkeys", nullptr, keys, mode, escape_csi);
+    client_.call(kFeedkeys, nullptr, keys, mode, escape_csi);
 }
 
 Integer Nvim::input(const std::string& keys) {
-    Integer res;
-    client_.call("nvim_input", res, keys);
+    Integer res{};
+    client_.call(kInput, res, decodeInteger, keys);
     return res;
 }
 
 void Nvim::input_mouse(const std::string& button, const std::string& action, const std::string& modifier, Integer grid, Integer row, Integer col) {
-    client_.call("nvim_input_mouse", nullptr, button, action, modifier, grid, row, col);
+    client_.call(kInputMouse, nullptr, button, action, modifier, grid, row, col);
 }
 
 std::string Nvim::replace_termcodes(const std::string& str, bool from_part, bool do_lt, bool special) {
-    std::string res;
-    client_.call("nvim_replace_termcodes", res, str, from_part, do_lt, special);
+    std::string res{};
+    client_.call(kReplaceTermcodes, res, decodeString, str, from_part, do_lt, special);
     return res;
 }
 
 std::string Nvim::command_output(const std::string& command) {
-    std::string res;
-    client_.call("nvim_command_output", res, command);
+    std::string res{};
+    client_.call(kCommandOutput, res, decodeString, command);
     return res;
 }
 
 Object Nvim::eval(const std::string& expr) {
-    Object res;
-    client_.call("nvim_eval", res, expr);
+    Object res{};
+    client_.call(kEval, res, decodeObject, expr);
     return res;
 }
 
 Object Nvim::execute_lua(const std::string& code, const Array& args) {
-    Object res;
-    client_.call("nvim_execute_lua", res, code, args);
+    Object res{};
+    client_.call(kExecuteLua, res, decodeObject, code, args);
     return res;
 }
 
 Object Nvim::call_function(const std::string& fn, const Array& args) {
-    Object res;
-    client_.call("nvim_call_function", res, fn, args);
+    Object res{};
+    client_.call(kCallFunction, res, decodeObject, fn, args);
     return res;
 }
 
 Object Nvim::call_dict_function(const Object& dict, const std::string& fn, const Array& args) {
-    Object res;
-    client_.call("nvim_call_dict_function", res, dict, fn, args);
+    Object res{};
+    client_.call(kCallDictFunction, res, decodeObject, dict, fn, args);
     return res;
 }
 
 Integer Nvim::strwidth(const std::string& text) {
-    Integer res;
-    client_.call("nvim_strwidth", res, text);
+    Integer res{};
+    client_.call(kStrwidth, res, decodeInteger, text);
     return res;
 }
 
 std::vector<std::string> Nvim::list_runtime_paths() {
-    std::vector<std::string> res;
-    client_.call("nvim_list_runtime_paths", res);
+    std::vector<std::string> res{};
+    client_.call(kListRuntimePaths, res, decodeArrayOfString);
     return res;
 }
 
 void Nvim::set_current_dir(const std::string& dir) {
-    client_.call("nvim_set_current_dir", nullptr, dir);
+    client_.call(kSetCurrentDir, nullptr, dir);
 }
 
 std::string Nvim::get_current_line() {
-    std::string res;
-    client_.call("nvim_get_current_line", res);
+    std::string res{};
+    client_.call(kGetCurrentLine, res, decodeString);
     return res;
 }
 
 void Nvim::set_current_line(const std::string& line) {
-    client_.call("nvim_set_current_line", nullptr, line);
+    client_.call(kSetCurrentLine, nullptr, line);
 }
 
 void Nvim::del_current_line() {
-    client_.call("nvim_del_current_line", nullptr);
+    client_.call(kDelCurrentLine, nullptr);
 }
 
 Object Nvim::get_var(const std::string& name) {
-    Object res;
-    client_.call("nvim_get_var", res, name);
+    Object res{};
+    client_.call(kGetVar, res, decodeObject, name);
     return res;
 }
 
 void Nvim::set_var(const std::string& name, const Object& value) {
-    client_.call("nvim_set_var", nullptr, name, value);
+    client_.call(kSetVar, nullptr, name, value);
 }
 
 void Nvim::del_var(const std::string& name) {
-    client_.call("nvim_del_var", nullptr, name);
+    client_.call(kDelVar, nullptr, name);
 }
 
 Object Nvim::get_vvar(const std::string& name) {
-    Object res;
-    client_.call("nvim_get_vvar", res, name);
+    Object res{};
+    client_.call(kGetVvar, res, decodeObject, name);
     return res;
 }
 
 void Nvim::set_vvar(const std::string& name, const Object& value) {
-    client_.call("nvim_set_vvar", nullptr, name, value);
+    client_.call(kSetVvar, nullptr, name, value);
 }
 
 Object Nvim::get_option(const std::string& name) {
-    Object res;
-    client_.call("nvim_get_option", res, name);
+    Object res{};
+    client_.call(kGetOption, res, decodeObject, name);
     return res;
 }
 
 void Nvim::set_option(const std::string& name, const Object& value) {
-    client_.call("nvim_set_option", nullptr, name, value);
+    client_.call(kSetOption, nullptr, name, value);
 }
 
 void Nvim::out_write(const std::string& str) {
-    client_.call("nvim_out_write", nullptr, str);
+    client_.call(kOutWrite, nullptr, str);
 }
 
 void Nvim::err_write(const std::string& str) {
-    client_.call("nvim_err_write", nullptr, str);
+    client_.call(kErrWrite, nullptr, str);
 }
 
 void Nvim::err_writeln(const std::string& str) {
-    client_.call("nvim_err_writeln", nullptr, str);
+    client_.call(kErrWriteln, nullptr, str);
 }
 
 std::vector<Buffer> Nvim::list_bufs() {
-    std::vector<Buffer> res;
-    client_.call("nvim_list_bufs", res);
+    std::vector<Buffer> res{};
+    client_.call(kListBufs, res, decodeArrayOfBuffer);
     return res;
 }
 
 Buffer Nvim::get_current_buf() {
-    Buffer res;
-    client_.call("nvim_get_current_buf", res);
+    Buffer res{};
+    client_.call(kGetCurrentBuf, res, decodeBuffer);
     return res;
 }
 
 void Nvim::set_current_buf(Buffer buffer) {
-    client_.call("nvim_set_current_buf", nullptr, buffer);
+    client_.call(kSetCurrentBuf, nullptr, buffer);
 }
 
 std::vector<Window> Nvim::list_wins() {
-    std::vector<Window> res;
-    client_.call("nvim_list_wins", res);
+    std::vector<Window> res{};
+    client_.call(kListWins, res, decodeArrayOfWindow);
     return res;
 }
 
 Window Nvim::get_current_win() {
-    Window res;
-    client_.call("nvim_get_current_win", res);
+    Window res{};
+    client_.call(kGetCurrentWin, res, decodeWindow);
     return res;
 }
 
 void Nvim::set_current_win(Window window) {
-    client_.call("nvim_set_current_win", nullptr, window);
+    client_.call(kSetCurrentWin, nullptr, window);
 }
 
 Buffer Nvim::create_buf(bool listed, bool scratch) {
-    Buffer res;
-    client_.call("nvim_create_buf", res, listed, scratch);
+    Buffer res{};
+    client_.call(kCreateBuf, res, decodeBuffer, listed, scratch);
     return res;
 }
 
 Window Nvim::open_win(Buffer buffer, bool enter, const Dictionary& config) {
-    Window res;
-    client_.call("nvim_open_win", res, buffer, enter, config);
+    Window res{};
+    client_.call(kOpenWin, res, decodeWindow, buffer, enter, config);
     return res;
 }
 
 std::vector<Tabpage> Nvim::list_tabpages() {
-    std::vector<Tabpage> res;
-    client_.call("nvim_list_tabpages", res);
+    std::vector<Tabpage> res{};
+    client_.call(kListTabpages, res, decodeArrayOfTabpage);
     return res;
 }
 
 Tabpage Nvim::get_current_tabpage() {
-    Tabpage res;
-    client_.call("nvim_get_current_tabpage", res);
+    Tabpage res{};
+    client_.call(kGetCurrentTabpage, res, decodeTabpage);
     return res;
 }
 
 void Nvim::set_current_tabpage(Tabpage tabpage) {
-    client_.call("nvim_set_current_tabpage", nullptr, tabpage);
+    client_.call(kSetCurrentTabpage, nullptr, tabpage);
 }
 
 Integer Nvim::create_namespace(const std::string& name) {
-    Integer res;
-    client_.call("nvim_create_namespace", res, name);
+    Integer res{};
+    client_.call(kCreateNamespace, res, decodeInteger, name);
     return res;
 }
 
 Dictionary Nvim::get_namespaces() {
-    Dictionary res;
-    client_.call("nvim_get_namespaces", res);
+    Dictionary res{};
+    client_.call(kGetNamespaces, res, decodeDictionary);
     return res;
 }
 
 bool Nvim::paste(const std::string& data, bool crlf, Integer phase) {
-    bool res;
-    client_.call("nvim_paste", res, data, crlf, phase);
+    bool res{};
+    client_.call(kPaste, res, decodeBoolean, data, crlf, phase);
     return res;
 }
 
 void Nvim::put(const std::vector<std::string>& lines, const std::string& type, bool after, bool follow) {
-    client_.call("nvim_put", nullptr, lines, type, after, follow);
+    client_.call(kPut, nullptr, lines, type, after, follow);
 }
 
 void Nvim::subscribe(const std::string& event) {
-    client_.call("nvim_subscribe", nullptr, event);
+    client_.call(kSubscribe, nullptr, event);
 }
 
 void Nvim::unsubscribe(const std::string& event) {
-    client_.call("nvim_unsubscribe", nullptr, event);
+    client_.call(kUnsubscribe, nullptr, event);
 }
 
 Integer Nvim::get_color_by_name(const std::string& name) {
-    Integer res;
-    client_.call("nvim_get_color_by_name", res, name);
+    Integer res{};
+    client_.call(kGetColorByName, res, decodeInteger, name);
     return res;
 }
 
 Dictionary Nvim::get_color_map() {
-    Dictionary res;
-    client_.call("nvim_get_color_map", res);
+    Dictionary res{};
+    client_.call(kGetColorMap, res, decodeDictionary);
     return res;
 }
 
 Dictionary Nvim::get_context(const Dictionary& opts) {
-    Dictionary res;
-    client_.call("nvim_get_context", res, opts);
+    Dictionary res{};
+    client_.call(kGetContext, res, decodeDictionary, opts);
     return res;
 }
 
 Object Nvim::load_context(const Dictionary& dict) {
-    Object res;
-    client_.call("nvim_load_context", res, dict);
+    Object res{};
+    client_.call(kLoadContext, res, decodeObject, dict);
     return res;
 }
 
 Dictionary Nvim::get_mode() {
-    Dictionary res;
-    client_.call("nvim_get_mode", res);
+    Dictionary res{};
+    client_.call(kGetMode, res, decodeDictionary);
     return res;
 }
 
 std::vector<Dictionary> Nvim::get_keymap(const std::string& mode) {
-    std::vector<Dictionary> res;
-    client_.call("nvim_get_keymap", res, mode);
+    std::vector<Dictionary> res{};
+    client_.call(kGetKeymap, res, decodeArrayOfDictionary, mode);
     return res;
 }
 
 void Nvim::set_keymap(const std::string& mode, const std::string& lhs, const std::string& rhs, const Dictionary& opts) {
-    client_.call("nvim_set_keymap", nullptr, mode, lhs, rhs, opts);
+    client_.call(kSetKeymap, nullptr, mode, lhs, rhs, opts);
 }
 
 void Nvim::del_keymap(const std::string& mode, const std::string& lhs) {
-    client_.call("nvim_del_keymap", nullptr, mode, lhs);
+    client_.call(kDelKeymap, nullptr, mode, lhs);
 }
 
 Dictionary Nvim::get_commands(const Dictionary& opts) {
-    Dictionary res;
-    client_.call("nvim_get_commands", res, opts);
+    Dictionary res{};
+    client_.call(kGetCommands, res, decodeDictionary, opts);
     return res;
 }
 
 Array Nvim::get_api_info() {
-    Array res;
-    client_.call("nvim_get_api_info", res);
+    Array res{};
+    client_.call(kGetApiInfo, res, decodeArray);
     return res;
 }
 
 void Nvim::set_client_info(const std::string& name, const Dictionary& version, const std::string& type, const Dictionary& methods, const Dictionary& attributes) {
-    client_.call("nvim_set_client_info", nullptr, name, version, type, methods, attributes);
+    client_.call(kSetClientInfo, nullptr, name, version, type, methods, attributes);
 }
 
 Dictionary Nvim::get_chan_info(Integer chan) {
-    Dictionary res;
-    client_.call("nvim_get_chan_info", res, chan);
+    Dictionary res{};
+    client_.call(kGetChanInfo, res, decodeDictionary, chan);
     return res;
 }
 
 Array Nvim::list_chans() {
-    Array res;
-    client_.call("nvim_list_chans", res);
+    Array res{};
+    client_.call(kListChans, res, decodeArray);
     return res;
 }
 
 Array Nvim::call_atomic(const Array& calls) {
-    Array res;
-    client_.call("nvim_call_atomic", res, calls);
+    Array res{};
+    client_.call(kCallAtomic, res, decodeArray, calls);
     return res;
 }
 
 Dictionary Nvim::parse_expression(const std::string& expr, const std::string& flags, bool highlight) {
-    Dictionary res;
-    client_.call("nvim_parse_expression", res, expr, flags, highlight);
+    Dictionary res{};
+    client_.call(kParseExpression, res, decodeDictionary, expr, flags, highlight);
     return res;
 }
 
 Array Nvim::list_uis() {
-    Array res;
-    client_.call("nvim_list_uis", res);
+    Array res{};
+    client_.call(kListUis, res, decodeArray);
     return res;
 }
 
 Array Nvim::get_proc_children(Integer pid) {
-    Array res;
-    client_.call("nvim_get_proc_children", res, pid);
+    Array res{};
+    client_.call(kGetProcChildren, res, decodeArray, pid);
     return res;
 }
 
 Object Nvim::get_proc(Integer pid) {
-    Object res;
-    client_.call("nvim_get_proc", res, pid);
+    Object res{};
+    client_.call(kGetProc, res, decodeObject, pid);
     return res;
 }
 
 void Nvim::select_popupmenu_item(Integer item, bool insert, bool finish, const Dictionary& opts) {
-    client_.call("nvim_select_popupmenu_item", nullptr, item, insert, finish, opts);
+    client_.call(kSelectPopupmenuItem, nullptr, item, insert, finish, opts);
 }
 
 Buffer Nvim::win_get_buf(Window window) {
-    Buffer res;
-    client_.call("nvim_win_get_buf", res, window);
+    Buffer res{};
+    client_.call(kWinGetBuf, res, decodeBuffer, window);
     return res;
 }
 
 void Nvim::win_set_buf(Window window, Buffer buffer) {
-    client_.call("nvim_win_set_buf", nullptr, window, buffer);
+    client_.call(kWinSetBuf, nullptr, window, buffer);
 }
 
 std::vector<Integer> Nvim::win_get_cursor(Window window) {
-    std::vector<Integer> res;
-    client_.call("nvim_win_get_cursor", res, window);
+    std::vector<Integer> res{};
+    client_.call(kWinGetCursor, res, decodeArrayOfInteger2, window);
     return res;
 }
 
 void Nvim::win_set_cursor(Window window, const std::vector<Integer>& pos) {
-    client_.call("nvim_win_set_cursor", nullptr, window, pos);
+    client_.call(kWinSetCursor, nullptr, window, pos);
 }
 
 Integer Nvim::win_get_height(Window window) {
-    Integer res;
-    client_.call("nvim_win_get_height", res, window);
+    Integer res{};
+    client_.call(kWinGetHeight, res, decodeInteger, window);
     return res;
 }
 
 void Nvim::win_set_height(Window window, Integer height) {
-    client_.call("nvim_win_set_height", nullptr, window, height);
+    client_.call(kWinSetHeight, nullptr, window, height);
 }
 
 Integer Nvim::win_get_width(Window window) {
-    Integer res;
-    client_.call("nvim_win_get_width", res, window);
+    Integer res{};
+    client_.call(kWinGetWidth, res, decodeInteger, window);
     return res;
 }
 
 void Nvim::win_set_width(Window window, Integer width) {
-    client_.call("nvim_win_set_width", nullptr, window, width);
+    client_.call(kWinSetWidth, nullptr, window, width);
 }
 
 Object Nvim::win_get_var(Window window, const std::string& name) {
-    Object res;
-    client_.call("nvim_win_get_var", res, window, name);
+    Object res{};
+    client_.call(kWinGetVar, res, decodeObject, window, name);
     return res;
 }
 
 void Nvim::win_set_var(Window window, const std::string& name, const Object& value) {
-    client_.call("nvim_win_set_var", nullptr, window, name, value);
+    client_.call(kWinSetVar, nullptr, window, name, value);
 }
 
 void Nvim::win_del_var(Window window, const std::string& name) {
-    client_.call("nvim_win_del_var", nullptr, window, name);
+    client_.call(kWinDelVar, nullptr, window, name);
 }
 
 Object Nvim::win_get_option(Window window, const std::string& name) {
-    Object res;
-    client_.call("nvim_win_get_option", res, window, name);
+    Object res{};
+    client_.call(kWinGetOption, res, decodeObject, window, name);
     return res;
 }
 
 void Nvim::win_set_option(Window window, const std::string& name, const Object& value) {
-    client_.call("nvim_win_set_option", nullptr, window, name, value);
+    client_.call(kWinSetOption, nullptr, window, name, value);
 }
 
 std::vector<Integer> Nvim::win_get_position(Window window) {
-    std::vector<Integer> res;
-    client_.call("nvim_win_get_position", res, window);
+    std::vector<Integer> res{};
+    client_.call(kWinGetPosition, res, decodeArrayOfInteger2, window);
     return res;
 }
 
 Tabpage Nvim::win_get_tabpage(Window window) {
-    Tabpage res;
-    client_.call("nvim_win_get_tabpage", res, window);
+    Tabpage res{};
+    client_.call(kWinGetTabpage, res, decodeTabpage, window);
     return res;
 }
 
 Integer Nvim::win_get_number(Window window) {
-    Integer res;
-    client_.call("nvim_win_get_number", res, window);
+    Integer res{};
+    client_.call(kWinGetNumber, res, decodeInteger, window);
     return res;
 }
 
 bool Nvim::win_is_valid(Window window) {
-    bool res;
-    client_.call("nvim_win_is_valid", res, window);
+    bool res{};
+    client_.call(kWinIsValid, res, decodeBoolean, window);
     return res;
 }
 
 void Nvim::win_set_config(Window window, const Dictionary& config) {
-    client_.call("nvim_win_set_config", nullptr, window, config);
+    client_.call(kWinSetConfig, nullptr, window, config);
 }
 
 Dictionary Nvim::win_get_config(Window window) {
-    Dictionary res;
-    client_.call("nvim_win_get_config", res, window);
+    Dictionary res{};
+    client_.call(kWinGetConfig, res, decodeDictionary, window);
     return res;
 }
 
 void Nvim::win_close(Window window, bool force) {
-    client_.call("nvim_win_close", nullptr, window, force);
+    client_.call(kWinClose, nullptr, window, force);
 }
 
 
 
 void Nvim::async_buf_line_count(Buffer buffer) {
-    client_.async_call("nvim_buf_line_count", buffer);
+    client_.async_call(kBufLineCount, buffer);
 }
 
 void Nvim::async_buf_attach(Buffer buffer, bool send_buffer, const Dictionary& opts) {
-    client_.async_call("nvim_buf_attach", buffer, send_buffer, opts);
+    client_.async_call(kBufAttach, buffer, send_buffer, opts);
 }
 
 void Nvim::async_buf_detach(Buffer buffer) {
-    client_.async_call("nvim_buf_detach", buffer);
+    client_.async_call(kBufDetach, buffer);
 }
 
 void Nvim::async_buf_get_lines(Buffer buffer, Integer start, Integer end, bool strict_indexing) {
-    client_.async_call("nvim_buf_get_lines", buffer, start, end, strict_indexing);
+    client_.async_call(kBufGetLines, buffer, start, end, strict_indexing);
 }
 
 void Nvim::async_buf_set_lines(Buffer buffer, Integer start, Integer end, bool strict_indexing, const std::vector<std::string>& replacement) {
-    client_.async_call("nvim_buf_set_lines", buffer, start, end, strict_indexing, replacement);
+    client_.async_call(kBufSetLines, buffer, start, end, strict_indexing, replacement);
 }
 
 void Nvim::async_buf_get_offset(Buffer buffer, Integer index) {
-    client_.async_call("nvim_buf_get_offset", buffer, index);
+    client_.async_call(kBufGetOffset, buffer, index);
 }
 
 void Nvim::async_buf_get_var(Buffer buffer, const std::string& name) {
-    client_.async_call("nvim_buf_get_var", buffer, name);
+    client_.async_call(kBufGetVar, buffer, name);
 }
 
 void Nvim::async_buf_get_changedtick(Buffer buffer) {
-    client_.async_call("nvim_buf_get_changedtick", buffer);
+    client_.async_call(kBufGetChangedtick, buffer);
 }
 
 void Nvim::async_buf_get_keymap(Buffer buffer, const std::string& mode) {
-    client_.async_call("nvim_buf_get_keymap", buffer, mode);
+    client_.async_call(kBufGetKeymap, buffer, mode);
 }
 
 void Nvim::async_buf_set_keymap(Buffer buffer, const std::string& mode, const std::string& lhs, const std::string& rhs, const Dictionary& opts) {
-    client_.async_call("nvim_buf_set_keymap", buffer, mode, lhs, rhs, opts);
+    client_.async_call(kBufSetKeymap, buffer, mode, lhs, rhs, opts);
 }
 
 void Nvim::async_buf_del_keymap(Buffer buffer, const std::string& mode, const std::string& lhs) {
-    client_.async_call("nvim_buf_del_keymap", buffer, mode, lhs);
+    client_.async_call(kBufDelKeymap, buffer, mode, lhs);
 }
 
 void Nvim::async_buf_get_commands(Buffer buffer, const Dictionary& opts) {
-    client_.async_call("nvim_buf_get_commands", buffer, opts);
+    client_.async_call(kBufGetCommands, buffer, opts);
 }
 
 void Nvim::async_buf_set_var(Buffer buffer, const std::string& name, const Object& value) {
-    client_.async_call("nvim_buf_set_var", buffer, name, value);
+    client_.async_call(kBufSetVar, buffer, name, value);
 }
 
 void Nvim::async_buf_del_var(Buffer buffer, const std::string& name) {
-    client_.async_call("nvim_buf_del_var", buffer, name);
+    client_.async_call(kBufDelVar, buffer, name);
 }
 
 void Nvim::async_buf_get_option(Buffer buffer, const std::string& name) {
-    client_.async_call("nvim_buf_get_option", buffer, name);
+    client_.async_call(kBufGetOption, buffer, name);
 }
 
 void Nvim::async_buf_set_option(Buffer buffer, const std::string& name, const Object& value) {
-    client_.async_call("nvim_buf_set_option", buffer, name, value);
+    client_.async_call(kBufSetOption, buffer, name, value);
 }
 
 void Nvim::async_buf_get_name(Buffer buffer) {
-    client_.async_call("nvim_buf_get_name", buffer);
+    client_.async_call(kBufGetName, buffer);
 }
 
 void Nvim::async_buf_set_name(Buffer buffer, const std::string& name) {
-    client_.async_call("nvim_buf_set_name", buffer, name);
+    client_.async_call(kBufSetName, buffer, name);
 }
 
 void Nvim::async_buf_is_loaded(Buffer buffer) {
-    client_.async_call("nvim_buf_is_loaded", buffer);
+    client_.async_call(kBufIsLoaded, buffer);
 }
 
 void Nvim::async_buf_is_valid(Buffer buffer) {
-    client_.async_call("nvim_buf_is_valid", buffer);
+    client_.async_call(kBufIsValid, buffer);
 }
 
 void Nvim::async_buf_get_mark(Buffer buffer, const std::string& name) {
-    client_.async_call("nvim_buf_get_mark", buffer, name);
+    client_.async_call(kBufGetMark, buffer, name);
 }
 
 void Nvim::async_buf_add_highlight(Buffer buffer, Integer ns_id, const std::string& hl_group, Integer line, Integer col_start, Integer col_end) {
-    client_.async_call("nvim_buf_add_highlight", buffer, ns_id, hl_group, line, col_start, col_end);
+    client_.async_call(kBufAddHighlight, buffer, ns_id, hl_group, line, col_start, col_end);
 }
 
 void Nvim::async_buf_clear_namespace(Buffer buffer, Integer ns_id, Integer line_start, Integer line_end) {
-    client_.async_call("nvim_buf_clear_namespace", buffer, ns_id, line_start, line_end);
+    client_.async_call(kBufClearNamespace, buffer, ns_id, line_start, line_end);
 }
 
 void Nvim::async_buf_clear_highlight(Buffer buffer, Integer ns_id, Integer line_start, Integer line_end) {
-    client_.async_call("nvim_buf_clear_highlight", buffer, ns_id, line_start, line_end);
+    client_.async_call(kBufClearHighlight, buffer, ns_id, line_start, line_end);
 }
 
 void Nvim::async_buf_set_virtual_text(Buffer buffer, Integer ns_id, Integer line, const Array& chunks, const Dictionary& opts) {
-    client_.async_call("nvim_buf_set_virtual_text", buffer, ns_id, line, chunks, opts);
+    client_.async_call(kBufSetVirtualText, buffer, ns_id, line, chunks, opts);
 }
 
 void Nvim::async_tabpage_list_wins(Tabpage tabpage) {
-    client_.async_call("nvim_tabpage_list_wins", tabpage);
+    client_.async_call(kTabpageListWins, tabpage);
 }
 
 void Nvim::async_tabpage_get_var(Tabpage tabpage, const std::string& name) {
-    client_.async_call("nvim_tabpage_get_var", tabpage, name);
+    client_.async_call(kTabpageGetVar, tabpage, name);
 }
 
 void Nvim::async_tabpage_set_var(Tabpage tabpage, const std::string& name, const Object& value) {
-    client_.async_call("nvim_tabpage_set_var", tabpage, name, value);
+    client_.async_call(kTabpageSetVar, tabpage, name, value);
 }
 
 void Nvim::async_tabpage_del_var(Tabpage tabpage, const std::string& name) {
-    client_.async_call("nvim_tabpage_del_var", tabpage, name);
+    client_.async_call(kTabpageDelVar, tabpage, name);
 }
 
 void Nvim::async_tabpage_get_win(Tabpage tabpage) {
-    client_.async_call("nvim_tabpage_get_win", tabpage);
+    client_.async_call(kTabpageGetWin, tabpage);
 }
 
 void Nvim::async_tabpage_get_number(Tabpage tabpage) {
-    client_.async_call("nvim_tabpage_get_number", tabpage);
+    client_.async_call(kTabpageGetNumber, tabpage);
 }
 
 void Nvim::async_tabpage_is_valid(Tabpage tabpage) {
-    client_.async_call("nvim_tabpage_is_valid", tabpage);
+    client_.async_call(kTabpageIsValid, tabpage);
 }
 
 void Nvim::async_ui_attach(Integer width, Integer height, const Dictionary& options) {
-    client_.async_call("nvim_ui_attach", width, height, options);
+    client_.async_call(kUiAttach, width, height, options);
 }
 
 void Nvim::async_ui_detach() {
-    client_.async_call("nvim_ui_detach");
+    client_.async_call(kUiDetach);
 }
 
 void Nvim::async_ui_try_resize(Integer width, Integer height) {
-    client_.async_call("nvim_ui_try_resize", width, height);
+    client_.async_call(kUiTryResize, width, height);
 }
 
 void Nvim::async_ui_set_option(const std::string& name, const Object& value) {
-    client_.async_call("nvim_ui_set_option", name, value);
+    client_.async_call(kUiSetOption, name, value);
 }
 
 void Nvim::async_ui_try_resize_grid(Integer grid, Integer width, Integer height) {
-    client_.async_call("nvim_ui_try_resize_grid", grid, width, height);
+    client_.async_call(kUiTryResizeGrid, grid, width, height);
 }
 
 void Nvim::async_ui_pum_set_height(Integer height) {
-    client_.async_call("nvim_ui_pum_set_height", height);
+    client_.async_call(kUiPumSetHeight, height);
 }
 
 void Nvim::async_command(const std::string& command) {
-    client_.async_call("nvim_command", command);
+    client_.async_call(kCommand, command);
 }
 
 void Nvim::async_get_hl_by_name(const std::string& name, bool rgb) {
-    client_.async_call("nvim_get_hl_by_name", name, rgb);
+    client_.async_call(kGetHlByName, name, rgb);
 }
 
 void Nvim::async_get_hl_by_id(Integer hl_id, bool rgb) {
-    client_.async_call("nvim_get_hl_by_id", hl_id, rgb);
+    client_.async_call(kGetHlById, hl_id, rgb);
 }
 
 void Nvim::async_feedkeys(const std::string& keys, const std::string& mode, bool escape_csi) {
-    client_.async_call("nvim_feedkeys", keys, mode, escape_csi);
+    client_.async_call(kFeedkeys, keys, mode, escape_csi);
 }
 
 void Nvim::async_input(const std::string& keys) {
-    client_.async_call("nvim_input", keys);
+    client_.async_call(kInput, keys);
 }
 
 void Nvim::async_input_mouse(const std::string& button, const std::string& action, const std::string& modifier, Integer grid, Integer row, Integer col) {
-    client_.async_call("nvim_input_mouse", button, action, modifier, grid, row, col);
+    client_.async_call(kInputMouse, button, action, modifier, grid, row, col);
 }
 
 void Nvim::async_replace_termcodes(const std::string& str, bool from_part, bool do_lt, bool special) {
-    client_.async_call("nvim_replace_termcodes", str, from_part, do_lt, special);
+    client_.async_call(kReplaceTermcodes, str, from_part, do_lt, special);
 }
 
 void Nvim::async_command_output(const std::string& command) {
-    client_.async_call("nvim_command_output", command);
+    client_.async_call(kCommandOutput, command);
 }
 
 void Nvim::async_eval(const std::string& expr) {
-    client_.async_call("nvim_eval", expr);
+    client_.async_call(kEval, expr);
 }
 
 void Nvim::async_execute_lua(const std::string& code, const Array& args) {
-    client_.async_call("nvim_execute_lua", code, args);
+    client_.async_call(kExecuteLua, code, args);
 }
 
 void Nvim::async_call_function(const std::string& fn, const Array& args) {
-    client_.async_call("nvim_call_function", fn, args);
+    client_.async_call(kCallFunction, fn, args);
 }
 
 void Nvim::async_call_dict_function(const Object& dict, const std::string& fn, const Array& args) {
-    client_.async_call("nvim_call_dict_function", dict, fn, args);
+    client_.async_call(kCallDictFunction, dict, fn, args);
 }
 
 void Nvim::async_strwidth(const std::string& text) {
-    client_.async_call("nvim_strwidth", text);
+    client_.async_call(kStrwidth, text);
 }
 
 void Nvim::async_list_runtime_paths() {
-    client_.async_call("nvim_list_runtime_paths");
+    client_.async_call(kListRuntimePaths);
 }
 
 void Nvim::async_set_current_dir(const std::string& dir) {
-    client_.async_call("nvim_set_current_dir", dir);
+    client_.async_call(kSetCurrentDir, dir);
 }
 
 void Nvim::async_get_current_line() {
-    client_.async_call("nvim_get_current_line");
+    client_.async_call(kGetCurrentLine);
 }
 
 void Nvim::async_set_current_line(const std::string& line) {
-    client_.async_call("nvim_set_current_line", line);
+    client_.async_call(kSetCurrentLine, line);
 }
 
 void Nvim::async_del_current_line() {
-    client_.async_call("nvim_del_current_line");
+    client_.async_call(kDelCurrentLine);
 }
 
 void Nvim::async_get_var(const std::string& name) {
-    client_.async_call("nvim_get_var", name);
+    client_.async_call(kGetVar, name);
 }
 
 void Nvim::async_set_var(const std::string& name, const Object& value) {
-    client_.async_call("nvim_set_var", name, value);
+    client_.async_call(kSetVar, name, value);
 }
 
 void Nvim::async_del_var(const std::string& name) {
-    client_.async_call("nvim_del_var", name);
+    client_.async_call(kDelVar, name);
 }
 
 void Nvim::async_get_vvar(const std::string& name) {
-    client_.async_call("nvim_get_vvar", name);
+    client_.async_call(kGetVvar, name);
 }
 
 void Nvim::async_set_vvar(const std::string& name, const Object& value) {
-    client_.async_call("nvim_set_vvar", name, value);
+    client_.async_call(kSetVvar, name, value);
 }
 
 void Nvim::async_get_option(const std::string& name) {
-    client_.async_call("nvim_get_option", name);
+    client_.async_call(kGetOption, name);
 }
 
 void Nvim::async_set_option(const std::string& name, const Object& value) {
-    client_.async_call("nvim_set_option", name, value);
+    client_.async_call(kSetOption, name, value);
 }
 
 void Nvim::async_out_write(const std::string& str) {
-    client_.async_call("nvim_out_write", str);
+    client_.async_call(kOutWrite, str);
 }
 
 void Nvim::async_err_write(const std::string& str) {
-    client_.async_call("nvim_err_write", str);
+    client_.async_call(kErrWrite, str);
 }
 
 void Nvim::async_err_writeln(const std::string& str) {
-    client_.async_call("nvim_err_writeln", str);
+    client_.async_call(kErrWriteln, str);
 }
 
 void Nvim::async_list_bufs() {
-    client_.async_call("nvim_list_bufs");
+    client_.async_call(kListBufs);
 }
 
 void Nvim::async_get_current_buf() {
-    client_.async_call("nvim_get_current_buf");
+    client_.async_call(kGetCurrentBuf);
 }
 
 void Nvim::async_set_current_buf(Buffer buffer) {
-    client_.async_call("nvim_set_current_buf", buffer);
+    client_.async_call(kSetCurrentBuf, buffer);
 }
 
 void Nvim::async_list_wins() {
-    client_.async_call("nvim_list_wins");
+    client_.async_call(kListWins);
 }
 
 void Nvim::async_get_current_win() {
-    client_.async_call("nvim_get_current_win");
+    client_.async_call(kGetCurrentWin);
 }
 
 void Nvim::async_set_current_win(Window window) {
-    client_.async_call("nvim_set_current_win", window);
+    client_.async_call(kSetCurrentWin, window);
 }
 
 void Nvim::async_create_buf(bool listed, bool scratch) {
-    client_.async_call("nvim_create_buf", listed, scratch);
+    client_.async_call(kCreateBuf, listed, scratch);
 }
 
 void Nvim::async_open_win(Buffer buffer, bool enter, const Dictionary& config) {
-    client_.async_call("nvim_open_win", buffer, enter, config);
+    client_.async_call(kOpenWin, buffer, enter, config);
 }
 
 void Nvim::async_list_tabpages() {
-    client_.async_call("nvim_list_tabpages");
+    client_.async_call(kListTabpages);
 }
 
 void Nvim::async_get_current_tabpage() {
-    client_.async_call("nvim_get_current_tabpage");
+    client_.async_call(kGetCurrentTabpage);
 }
 
 void Nvim::async_set_current_tabpage(Tabpage tabpage) {
-    client_.async_call("nvim_set_current_tabpage", tabpage);
+    client_.async_call(kSetCurrentTabpage, tabpage);
 }
 
 void Nvim::async_create_namespace(const std::string& name) {
-    client_.async_call("nvim_create_namespace", name);
+    client_.async_call(kCreateNamespace, name);
 }
 
 void Nvim::async_get_namespaces() {
-    client_.async_call("nvim_get_namespaces");
+    client_.async_call(kGetNamespaces);
 }
 
 void Nvim::async_paste(const std::string& data, bool crlf, Integer phase) {
-    client_.async_call("nvim_paste", data, crlf, phase);
+    client_.async_call(kPaste, data, crlf, phase);
 }
 
 void Nvim::async_put(const std::vector<std::string>& lines, const std::string& type, bool after, bool follow) {
-    client_.async_call("nvim_put", lines, type, after, follow);
+    client_.async_call(kPut, lines, type, after, follow);
 }
 
 void Nvim::async_subscribe(const std::string& event) {
-    client_.async_call("nvim_subscribe", event);
+    client_.async_call(kSubscribe, event);
 }
 
 void Nvim::async_unsubscribe(const std::string& event) {
-    client_.async_call("nvim_unsubscribe", event);
+    client_.async_call(kUnsubscribe, event);
 }
 
 void Nvim::async_get_color_by_name(const std::string& name) {
-    client_.async_call("nvim_get_color_by_name", name);
+    client_.async_call(kGetColorByName, name);
 }
 
 void Nvim::async_get_color_map() {
-    client_.async_call("nvim_get_color_map");
+    client_.async_call(kGetColorMap);
 }
 
 void Nvim::async_get_context(const Dictionary& opts) {
-    client_.async_call("nvim_get_context", opts);
+    client_.async_call(kGetContext, opts);
 }
 
 void Nvim::async_load_context(const Dictionary& dict) {
-    client_.async_call("nvim_load_context", dict);
+    client_.async_call(kLoadContext, dict);
 }
 
 void Nvim::async_get_mode() {
-    client_.async_call("nvim_get_mode");
+    client_.async_call(kGetMode);
 }
 
 void Nvim::async_get_keymap(const std::string& mode) {
-    client_.async_call("nvim_get_keymap", mode);
+    client_.async_call(kGetKeymap, mode);
 }
 
 void Nvim::async_set_keymap(const std::string& mode, const std::string& lhs, const std::string& rhs, const Dictionary& opts) {
-    client_.async_call("nvim_set_keymap", mode, lhs, rhs, opts);
+    client_.async_call(kSetKeymap, mode, lhs, rhs, opts);
 }
 
 void Nvim::async_del_keymap(const std::string& mode, const std::string& lhs) {
-    client_.async_call("nvim_del_keymap", mode, lhs);
+    client_.async_call(kDelKeymap, mode, lhs);
 }
 
 void Nvim::async_get_commands(const Dictionary& opts) {
-    client_.async_call("nvim_get_commands", opts);
+    client_.async_call(kGetCommands, opts);
 }
 
 void Nvim::async_get_api_info() {
-    client_.async_call("nvim_get_api_info");
+    client_.async_call(kGetApiInfo);
 }
 
 void Nvim::async_set_client_info(const std::string& name, const Dictionary& version, const std::string& type, const Dictionary& methods, const Dictionary& attributes) {
-    client_.async_call("nvim_set_client_info", name, version, type, methods, attributes);
+    client_.async_call(kSetClientInfo, name, version, type, methods, attributes);
 }
 
 void Nvim::async_get_chan_info(Integer chan) {
-    client_.async_call("nvim_get_chan_info", chan);
+    client_.async_call(kGetChanInfo, chan);
 }
 
 void Nvim::async_list_chans() {
-    client_.async_call("nvim_list_chans");
+    client_.async_call(kListChans);
 }
 
 void Nvim::async_call_atomic(const Array& calls) {
-    client_.async_call("nvim_call_atomic", calls);
+    client_.async_call(kCallAtomic, calls);
 }
 
 void Nvim::async_parse_expression(const std::string& expr, const std::string& flags, bool highlight) {
-    client_.async_call("nvim_parse_expression", expr, flags, highlight);
+    client_.async_call(kParseExpression, expr, flags, highlight);
 }
 
 void Nvim::async_list_uis() {
-    client_.async_call("nvim_list_uis");
+    client_.async_call(kListUis);
 }
 
 void Nvim::async_get_proc_children(Integer pid) {
-    client_.async_call("nvim_get_proc_children", pid);
+    client_.async_call(kGetProcChildren, pid);
 }
 
 void Nvim::async_get_proc(Integer pid) {
-    client_.async_call("nvim_get_proc", pid);
+    client_.async_call(kGetProc, pid);
 }
 
 void Nvim::async_select_popupmenu_item(Integer item, bool insert, bool finish, const Dictionary& opts) {
-    client_.async_call("nvim_select_popupmenu_item", item, insert, finish, opts);
+    client_.async_call(kSelectPopupmenuItem, item, insert, finish, opts);
 }
 
 void Nvim::async_win_get_buf(Window window) {
-    client_.async_call("nvim_win_get_buf", window);
+    client_.async_call(kWinGetBuf, window);
 }
 
 void Nvim::async_win_set_buf(Window window, Buffer buffer) {
-    client_.async_call("nvim_win_set_buf", window, buffer);
+    client_.async_call(kWinSetBuf, window, buffer);
 }
 
 void Nvim::async_win_get_cursor(Window window) {
-    client_.async_call("nvim_win_get_cursor", window);
+    client_.async_call(kWinGetCursor, window);
 }
 
 void Nvim::async_win_set_cursor(Window window, const std::vector<Integer>& pos) {
-    client_.async_call("nvim_win_set_cursor", window, pos);
+    client_.async_call(kWinSetCursor, window, pos);
 }
 
 void Nvim::async_win_get_height(Window window) {
-    client_.async_call("nvim_win_get_height", window);
+    client_.async_call(kWinGetHeight, window);
 }
 
 void Nvim::async_win_set_height(Window window, Integer height) {
-    client_.async_call("nvim_win_set_height", window, height);
+    client_.async_call(kWinSetHeight, window, height);
 }
 
 void Nvim::async_win_get_width(Window window) {
-    client_.async_call("nvim_win_get_width", window);
+    client_.async_call(kWinGetWidth, window);
 }
 
 void Nvim::async_win_set_width(Window window, Integer width) {
-    client_.async_call("nvim_win_set_width", window, width);
+    client_.async_call(kWinSetWidth, window, width);
 }
 
 void Nvim::async_win_get_var(Window window, const std::string& name) {
-    client_.async_call("nvim_win_get_var", window, name);
+    client_.async_call(kWinGetVar, window, name);
 }
 
 void Nvim::async_win_set_var(Window window, const std::string& name, const Object& value) {
-    client_.async_call("nvim_win_set_var", window, name, value);
+    client_.async_call(kWinSetVar, window, name, value);
 }
 
 void Nvim::async_win_del_var(Window window, const std::string& name) {
-    client_.async_call("nvim_win_del_var", window, name);
+    client_.async_call(kWinDelVar, window, name);
 }
 
 void Nvim::async_win_get_option(Window window, const std::string& name) {
-    client_.async_call("nvim_win_get_option", window, name);
+    client_.async_call(kWinGetOption, window, name);
 }
 
 void Nvim::async_win_set_option(Window window, const std::string& name, const Object& value) {
-    client_.async_call("nvim_win_set_option", window, name, value);
+    client_.async_call(kWinSetOption, window, name, value);
 }
 
 void Nvim::async_win_get_position(Window window) {
-    client_.async_call("nvim_win_get_position", window);
+    client_.async_call(kWinGetPosition, window);
 }
 
 void Nvim::async_win_get_tabpage(Window window) {
-    client_.async_call("nvim_win_get_tabpage", window);
+    client_.async_call(kWinGetTabpage, window);
 }
 
 void Nvim::async_win_get_number(Window window) {
-    client_.async_call("nvim_win_get_number", window);
+    client_.async_call(kWinGetNumber, window);
 }
 
 void Nvim::async_win_is_valid(Window window) {
-    client_.async_call("nvim_win_is_valid", window);
+    client_.async_call(kWinIsValid, window);
 }
 
 void Nvim::async_win_set_config(Window window, const Dictionary& config) {
-    client_.async_call("nvim_win_set_config", window, config);
+    client_.async_call(kWinSetConfig, window, config);
 }
 
 void Nvim::async_win_get_config(Window window) {
-    client_.async_call("nvim_win_get_config", window);
+    client_.async_call(kWinGetConfig, window);
 }
 
 void Nvim::async_win_close(Window window, bool force) {
-    client_.async_call("nvim_win_close", window, force);
+    client_.async_call(kWinClose, window, force);
+}
+
+
+
+Future<Integer> Nvim::future_buf_line_count(Buffer buffer) {
+    return client_.future_call(kBufLineCount, decodeInteger, buffer);
+}
+
+Future<bool> Nvim::future_buf_attach(Buffer buffer, bool send_buffer, const Dictionary& opts) {
+    return client_.future_call(kBufAttach, decodeBoolean, buffer, send_buffer, opts);
+}
+
+Future<bool> Nvim::future_buf_detach(Buffer buffer) {
+    return client_.future_call(kBufDetach, decodeBoolean, buffer);
+}
+
+Future<std::vector<std::string>> Nvim::future_buf_get_lines(Buffer buffer, Integer start, Integer end, bool strict_indexing) {
+    return client_.future_call(kBufGetLines, decodeArrayOfString, buffer, start, end, strict_indexing);
+}
+
+Future<void> Nvim::future_buf_set_lines(Buffer buffer, Integer start, Integer end, bool strict_indexing, const std::vector<std::string>& replacement) {
+    return client_.future_call(kBufSetLines, nullptr, buffer, start, end, strict_indexing, replacement);
+}
+
+Future<Integer> Nvim::future_buf_get_offset(Buffer buffer, Integer index) {
+    return client_.future_call(kBufGetOffset, decodeInteger, buffer, index);
+}
+
+Future<Object> Nvim::future_buf_get_var(Buffer buffer, const std::string& name) {
+    return client_.future_call(kBufGetVar, decodeObject, buffer, name);
+}
+
+Future<Integer> Nvim::future_buf_get_changedtick(Buffer buffer) {
+    return client_.future_call(kBufGetChangedtick, decodeInteger, buffer);
+}
+
+Future<std::vector<Dictionary>> Nvim::future_buf_get_keymap(Buffer buffer, const std::string& mode) {
+    return client_.future_call(kBufGetKeymap, decodeArrayOfDictionary, buffer, mode);
+}
+
+Future<void> Nvim::future_buf_set_keymap(Buffer buffer, const std::string& mode, const std::string& lhs, const std::string& rhs, const Dictionary& opts) {
+    return client_.future_call(kBufSetKeymap, nullptr, buffer, mode, lhs, rhs, opts);
+}
+
+Future<void> Nvim::future_buf_del_keymap(Buffer buffer, const std::string& mode, const std::string& lhs) {
+    return client_.future_call(kBufDelKeymap, nullptr, buffer, mode, lhs);
+}
+
+Future<Dictionary> Nvim::future_buf_get_commands(Buffer buffer, const Dictionary& opts) {
+    return client_.future_call(kBufGetCommands, decodeDictionary, buffer, opts);
+}
+
+Future<void> Nvim::future_buf_set_var(Buffer buffer, const std::string& name, const Object& value) {
+    return client_.future_call(kBufSetVar, nullptr, buffer, name, value);
+}
+
+Future<void> Nvim::future_buf_del_var(Buffer buffer, const std::string& name) {
+    return client_.future_call(kBufDelVar, nullptr, buffer, name);
+}
+
+Future<Object> Nvim::future_buf_get_option(Buffer buffer, const std::string& name) {
+    return client_.future_call(kBufGetOption, decodeObject, buffer, name);
+}
+
+Future<void> Nvim::future_buf_set_option(Buffer buffer, const std::string& name, const Object& value) {
+    return client_.future_call(kBufSetOption, nullptr, buffer, name, value);
+}
+
+Future<std::string> Nvim::future_buf_get_name(Buffer buffer) {
+    return client_.future_call(kBufGetName, decodeString, buffer);
+}
+
+Future<void> Nvim::future_buf_set_name(Buffer buffer, const std::string& name) {
+    return client_.future_call(kBufSetName, nullptr, buffer, name);
+}
+
+Future<bool> Nvim::future_buf_is_loaded(Buffer buffer) {
+    return client_.future_call(kBufIsLoaded, decodeBoolean, buffer);
+}
+
+Future<bool> Nvim::future_buf_is_valid(Buffer buffer) {
+    return client_.future_call(kBufIsValid, decodeBoolean, buffer);
+}
+
+Future<std::vector<Integer>> Nvim::future_buf_get_mark(Buffer buffer, const std::string& name) {
+    return client_.future_call(kBufGetMark, decodeArrayOfInteger2, buffer, name);
+}
+
+Future<Integer> Nvim::future_buf_add_highlight(Buffer buffer, Integer ns_id, const std::string& hl_group, Integer line, Integer col_start, Integer col_end) {
+    return client_.future_call(kBufAddHighlight, decodeInteger, buffer, ns_id, hl_group, line, col_start, col_end);
+}
+
+Future<void> Nvim::future_buf_clear_namespace(Buffer buffer, Integer ns_id, Integer line_start, Integer line_end) {
+    return client_.future_call(kBufClearNamespace, nullptr, buffer, ns_id, line_start, line_end);
+}
+
+Future<void> Nvim::future_buf_clear_highlight(Buffer buffer, Integer ns_id, Integer line_start, Integer line_end) {
+    return client_.future_call(kBufClearHighlight, nullptr, buffer, ns_id, line_start, line_end);
+}
+
+Future<Integer> Nvim::future_buf_set_virtual_text(Buffer buffer, Integer ns_id, Integer line, const Array& chunks, const Dictionary& opts) {
+    return client_.future_call(kBufSetVirtualText, decodeInteger, buffer, ns_id, line, chunks, opts);
+}
+
+Future<std::vector<Window>> Nvim::future_tabpage_list_wins(Tabpage tabpage) {
+    return client_.future_call(kTabpageListWins, decodeArrayOfWindow, tabpage);
+}
+
+Future<Object> Nvim::future_tabpage_get_var(Tabpage tabpage, const std::string& name) {
+    return client_.future_call(kTabpageGetVar, decodeObject, tabpage, name);
+}
+
+Future<void> Nvim::future_tabpage_set_var(Tabpage tabpage, const std::string& name, const Object& value) {
+    return client_.future_call(kTabpageSetVar, nullptr, tabpage, name, value);
+}
+
+Future<void> Nvim::future_tabpage_del_var(Tabpage tabpage, const std::string& name) {
+    return client_.future_call(kTabpageDelVar, nullptr, tabpage, name);
+}
+
+Future<Window> Nvim::future_tabpage_get_win(Tabpage tabpage) {
+    return client_.future_call(kTabpageGetWin, decodeWindow, tabpage);
+}
+
+Future<Integer> Nvim::future_tabpage_get_number(Tabpage tabpage) {
+    return client_.future_call(kTabpageGetNumber, decodeInteger, tabpage);
+}
+
+Future<bool> Nvim::future_tabpage_is_valid(Tabpage tabpage) {
+    return client_.future_call(kTabpageIsValid, decodeBoolean, tabpage);
+}
+
+Future<void> Nvim::future_ui_attach(Integer width, Integer height, const Dictionary& options) {
+    return client_.future_call(kUiAttach, nullptr, width, height, options);
+}
+
+Future<void> Nvim::future_ui_detach() {
+    return client_.future_call(kUiDetach, nullptr);
+}
+
+Future<void> Nvim::future_ui_try_resize(Integer width, Integer height) {
+    return client_.future_call(kUiTryResize, nullptr, width, height);
+}
+
+Future<void> Nvim::future_ui_set_option(const std::string& name, const Object& value) {
+    return client_.future_call(kUiSetOption, nullptr, name, value);
+}
+
+Future<void> Nvim::future_ui_try_resize_grid(Integer grid, Integer width, Integer height) {
+    return client_.future_call(kUiTryResizeGrid, nullptr, grid, width, height);
+}
+
+Future<void> Nvim::future_ui_pum_set_height(Integer height) {
+    return client_.future_call(kUiPumSetHeight, nullptr, height);
+}
+
+Future<void> Nvim::future_command(const std::string& command) {
+    return client_.future_call(kCommand, nullptr, command);
+}
+
+Future<Dictionary> Nvim::future_get_hl_by_name(const std::string& name, bool rgb) {
+    return client_.future_call(kGetHlByName, decodeDictionary, name, rgb);
+}
+
+Future<Dictionary> Nvim::future_get_hl_by_id(Integer hl_id, bool rgb) {
+    return client_.future_call(kGetHlById, decodeDictionary, hl_id, rgb);
+}
+
+Future<void> Nvim::future_feedkeys(const std::string& keys, const std::string& mode, bool escape_csi) {
+    return client_.future_call(kFeedkeys, nullptr, keys, mode, escape_csi);
+}
+
+Future<Integer> Nvim::future_input(const std::string& keys) {
+    return client_.future_call(kInput, decodeInteger, keys);
+}
+
+Future<void> Nvim::future_input_mouse(const std::string& button, const std::string& action, const std::string& modifier, Integer grid, Integer row, Integer col) {
+    return client_.future_call(kInputMouse, nullptr, button, action, modifier, grid, row, col);
+}
+
+Future<std::string> Nvim::future_replace_termcodes(const std::string& str, bool from_part, bool do_lt, bool special) {
+    return client_.future_call(kReplaceTermcodes, decodeString, str, from_part, do_lt, special);
+}
+
+Future<std::string> Nvim::future_command_output(const std::string& command) {
+    return client_.future_call(kCommandOutput, decodeString, command);
+}
+
+Future<Object> Nvim::future_eval(const std::string& expr) {
+    return client_.future_call(kEval, decodeObject, expr);
+}
+
+Future<Object> Nvim::future_execute_lua(const std::string& code, const Array& args) {
+    return client_.future_call(kExecuteLua, decodeObject, code, args);
+}
+
+Future<Object> Nvim::future_call_function(const std::string& fn, const Array& args) {
+    return client_.future_call(kCallFunction, decodeObject, fn, args);
+}
+
+Future<Object> Nvim::future_call_dict_function(const Object& dict, const std::string& fn, const Array& args) {
+    return client_.future_call(kCallDictFunction, decodeObject, dict, fn, args);
+}
+
+Future<Integer> Nvim::future_strwidth(const std::string& text) {
+    return client_.future_call(kStrwidth, decodeInteger, text);
+}
+
+Future<std::vector<std::string>> Nvim::future_list_runtime_paths() {
+    return client_.future_call(kListRuntimePaths, decodeArrayOfString);
+}
+
+Future<void> Nvim::future_set_current_dir(const std::string& dir) {
+    return client_.future_call(kSetCurrentDir, nullptr, dir);
+}
+
+Future<std::string> Nvim::future_get_current_line() {
+    return client_.future_call(kGetCurrentLine, decodeString);
+}
+
+Future<void> Nvim::future_set_current_line(const std::string& line) {
+    return client_.future_call(kSetCurrentLine, nullptr, line);
+}
+
+Future<void> Nvim::future_del_current_line() {
+    return client_.future_call(kDelCurrentLine, nullptr);
+}
+
+Future<Object> Nvim::future_get_var(const std::string& name) {
+    return client_.future_call(kGetVar, decodeObject, name);
+}
+
+Future<void> Nvim::future_set_var(const std::string& name, const Object& value) {
+    return client_.future_call(kSetVar, nullptr, name, value);
+}
+
+Future<void> Nvim::future_del_var(const std::string& name) {
+    return client_.future_call(kDelVar, nullptr, name);
+}
+
+Future<Object> Nvim::future_get_vvar(const std::string& name) {
+    return client_.future_call(kGetVvar, decodeObject, name);
+}
+
+Future<void> Nvim::future_set_vvar(const std::string& name, const Object& value) {
+    return client_.future_call(kSetVvar, nullptr, name, value);
+}
+
+Future<Object> Nvim::future_get_option(const std::string& name) {
+    return client_.future_call(kGetOption, decodeObject, name);
+}
+
+Future<void> Nvim::future_set_option(const std::string& name, const Object& value) {
+    return client_.future_call(kSetOption, nullptr, name, value);
+}
+
+Future<void> Nvim::future_out_write(const std::string& str) {
+    return client_.future_call(kOutWrite, nullptr, str);
+}
+
+Future<void> Nvim::future_err_write(const std::string& str) {
+    return client_.future_call(kErrWrite, nullptr, str);
+}
+
+Future<void> Nvim::future_err_writeln(const std::string& str) {
+    return client_.future_call(kErrWriteln, nullptr, str);
+}
+
+Future<std::vector<Buffer>> Nvim::future_list_bufs() {
+    return client_.future_call(kListBufs, decodeArrayOfBuffer);
+}
+
+Future<Buffer> Nvim::future_get_current_buf() {
+    return client_.future_call(kGetCurrentBuf, decodeBuffer);
+}
+
+Future<void> Nvim::future_set_current_buf(Buffer buffer) {
+    return client_.future_call(kSetCurrentBuf, nullptr, buffer);
+}
+
+Future<std::vector<Window>> Nvim::future_list_wins() {
+    return client_.future_call(kListWins, decodeArrayOfWindow);
+}
+
+Future<Window> Nvim::future_get_current_win() {
+    return client_.future_call(kGetCurrentWin, decodeWindow);
+}
+
+Future<void> Nvim::future_set_current_win(Window window) {
+    return client_.future_call(kSetCurrentWin, nullptr, window);
+}
+
+Future<Buffer> Nvim::future_create_buf(bool listed, bool scratch) {
+    return client_.future_call(kCreateBuf, decodeBuffer, listed, scratch);
+}
+
+Future<Window> Nvim::future_open_win(Buffer buffer, bool enter, const Dictionary& config) {
+    return client_.future_call(kOpenWin, decodeWindow, buffer, enter, config);
+}
+
+Future<std::vector<Tabpage>> Nvim::future_list_tabpages() {
+    return client_.future_call(kListTabpages, decodeArrayOfTabpage);
+}
+
+Future<Tabpage> Nvim::future_get_current_tabpage() {
+    return client_.future_call(kGetCurrentTabpage, decodeTabpage);
+}
+
+Future<void> Nvim::future_set_current_tabpage(Tabpage tabpage) {
+    return client_.future_call(kSetCurrentTabpage, nullptr, tabpage);
+}
+
+Future<Integer> Nvim::future_create_namespace(const std::string& name) {
+    return client_.future_call(kCreateNamespace, decodeInteger, name);
+}
+
+Future<Dictionary> Nvim::future_get_namespaces() {
+    return client_.future_call(kGetNamespaces, decodeDictionary);
+}
+
+Future<bool> Nvim::future_paste(const std::string& data, bool crlf, Integer phase) {
+    return client_.future_call(kPaste, decodeBoolean, data, crlf, phase);
+}
+
+Future<void> Nvim::future_put(const std::vector<std::string>& lines, const std::string& type, bool after, bool follow) {
+    return client_.future_call(kPut, nullptr, lines, type, after, follow);
+}
+
+Future<void> Nvim::future_subscribe(const std::string& event) {
+    return client_.future_call(kSubscribe, nullptr, event);
+}
+
+Future<void> Nvim::future_unsubscribe(const std::string& event) {
+    return client_.future_call(kUnsubscribe, nullptr, event);
+}
+
+Future<Integer> Nvim::future_get_color_by_name(const std::string& name) {
+    return client_.future_call(kGetColorByName, decodeInteger, name);
+}
+
+Future<Dictionary> Nvim::future_get_color_map() {
+    return client_.future_call(kGetColorMap, decodeDictionary);
+}
+
+Future<Dictionary> Nvim::future_get_context(const Dictionary& opts) {
+    return client_.future_call(kGetContext, decodeDictionary, opts);
+}
+
+Future<Object> Nvim::future_load_context(const Dictionary& dict) {
+    return client_.future_call(kLoadContext, decodeObject, dict);
+}
+
+Future<Dictionary> Nvim::future_get_mode() {
+    return client_.future_call(kGetMode, decodeDictionary);
+}
+
+Future<std::vector<Dictionary>> Nvim::future_get_keymap(const std::string& mode) {
+    return client_.future_call(kGetKeymap, decodeArrayOfDictionary, mode);
+}
+
+Future<void> Nvim::future_set_keymap(const std::string& mode, const std::string& lhs, const std::string& rhs, const Dictionary& opts) {
+    return client_.future_call(kSetKeymap, nullptr, mode, lhs, rhs, opts);
+}
+
+Future<void> Nvim::future_del_keymap(const std::string& mode, const std::string& lhs) {
+    return client_.future_call(kDelKeymap, nullptr, mode, lhs);
+}
+
+Future<Dictionary> Nvim::future_get_commands(const Dictionary& opts) {
+    return client_.future_call(kGetCommands, decodeDictionary, opts);
+}
+
+Future<Array> Nvim::future_get_api_info() {
+    return client_.future_call(kGetApiInfo, decodeArray);
+}
+
+Future<void> Nvim::future_set_client_info(const std::string& name, const Dictionary& version, const std::string& type, const Dictionary& methods, const Dictionary& attributes) {
+    return client_.future_call(kSetClientInfo, nullptr, name, version, type, methods, attributes);
+}
+
+Future<Dictionary> Nvim::future_get_chan_info(Integer chan) {
+    return client_.future_call(kGetChanInfo, decodeDictionary, chan);
+}
+
+Future<Array> Nvim::future_list_chans() {
+    return client_.future_call(kListChans, decodeArray);
+}
+
+Future<Array> Nvim::future_call_atomic(const Array& calls) {
+    return client_.future_call(kCallAtomic, decodeArray, calls);
+}
+
+Future<Dictionary> Nvim::future_parse_expression(const std::string& expr, const std::string& flags, bool highlight) {
+    return client_.future_call(kParseExpression, decodeDictionary, expr, flags, highlight);
+}
+
+Future<Array> Nvim::future_list_uis() {
+    return client_.future_call(kListUis, decodeArray);
+}
+
+Future<Array> Nvim::future_get_proc_children(Integer pid) {
+    return client_.future_call(kGetProcChildren, decodeArray, pid);
+}
+
+Future<Object> Nvim::future_get_proc(Integer pid) {
+    return client_.future_call(kGetProc, decodeObject, pid);
+}
+
+Future<void> Nvim::future_select_popupmenu_item(Integer item, bool insert, bool finish, const Dictionary& opts) {
+    return client_.future_call(kSelectPopupmenuItem, nullptr, item, insert, finish, opts);
+}
+
+Future<Buffer> Nvim::future_win_get_buf(Window window) {
+    return client_.future_call(kWinGetBuf, decodeBuffer, window);
+}
+
+Future<void> Nvim::future_win_set_buf(Window window, Buffer buffer) {
+    return client_.future_call(kWinSetBuf, nullptr, window, buffer);
+}
+
+Future<std::vector<Integer>> Nvim::future_win_get_cursor(Window window) {
+    return client_.future_call(kWinGetCursor, decodeArrayOfInteger2, window);
+}
+
+Future<void> Nvim::future_win_set_cursor(Window window, const std::vector<Integer>& pos) {
+    return client_.future_call(kWinSetCursor, nullptr, window, pos);
+}
+
+Future<Integer> Nvim::future_win_get_height(Window window) {
+    return client_.future_call(kWinGetHeight, decodeInteger, window);
+}
+
+Future<void> Nvim::future_win_set_height(Window window, Integer height) {
+    return client_.future_call(kWinSetHeight, nullptr, window, height);
+}
+
+Future<Integer> Nvim::future_win_get_width(Window window) {
+    return client_.future_call(kWinGetWidth, decodeInteger, window);
+}
+
+Future<void> Nvim::future_win_set_width(Window window, Integer width) {
+    return client_.future_call(kWinSetWidth, nullptr, window, width);
+}
+
+Future<Object> Nvim::future_win_get_var(Window window, const std::string& name) {
+    return client_.future_call(kWinGetVar, decodeObject, window, name);
+}
+
+Future<void> Nvim::future_win_set_var(Window window, const std::string& name, const Object& value) {
+    return client_.future_call(kWinSetVar, nullptr, window, name, value);
+}
+
+Future<void> Nvim::future_win_del_var(Window window, const std::string& name) {
+    return client_.future_call(kWinDelVar, nullptr, window, name);
+}
+
+Future<Object> Nvim::future_win_get_option(Window window, const std::string& name) {
+    return client_.future_call(kWinGetOption, decodeObject, window, name);
+}
+
+Future<void> Nvim::future_win_set_option(Window window, const std::string& name, const Object& value) {
+    return client_.future_call(kWinSetOption, nullptr, window, name, value);
+}
+
+Future<std::vector<Integer>> Nvim::future_win_get_position(Window window) {
+    return client_.future_call(kWinGetPosition, decodeArrayOfInteger2, window);
+}
+
+Future<Tabpage> Nvim::future_win_get_tabpage(Window window) {
+    return client_.future_call(kWinGetTabpage, decodeTabpage, window);
+}
+
+Future<Integer> Nvim::future_win_get_number(Window window) {
+    return client_.future_call(kWinGetNumber, decodeInteger, window);
+}
+
+Future<bool> Nvim::future_win_is_valid(Window window) {
+    return client_.future_call(kWinIsValid, decodeBoolean, window);
+}
+
+Future<void> Nvim::future_win_set_config(Window window, const Dictionary& config) {
+    return client_.future_call(kWinSetConfig, nullptr, window, config);
+}
+
+Future<Dictionary> Nvim::future_win_get_config(Window window) {
+    return client_.future_call(kWinGetConfig, decodeDictionary, window);
+}
+
+Future<void> Nvim::future_win_close(Window window, bool force) {
+    return client_.future_call(kWinClose, nullptr, window, force);
+}
+
+
+
+BatchItem<Integer> Nvim::Batch::buf_line_count(Buffer buffer) {
+    return BatchItem<Integer>(add(kBufLineCount, buffer), decodeInteger);
+}
+
+BatchItem<bool> Nvim::Batch::buf_attach(Buffer buffer, bool send_buffer, const Dictionary& opts) {
+    return BatchItem<bool>(add(kBufAttach, buffer, send_buffer, opts), decodeBoolean);
+}
+
+BatchItem<bool> Nvim::Batch::buf_detach(Buffer buffer) {
+    return BatchItem<bool>(add(kBufDetach, buffer), decodeBoolean);
+}
+
+BatchItem<std::vector<std::string>> Nvim::Batch::buf_get_lines(Buffer buffer, Integer start, Integer end, bool strict_indexing) {
+    return BatchItem<std::vector<std::string>>(add(kBufGetLines, buffer, start, end, strict_indexing), decodeArrayOfString);
+}
+
+BatchItem<void> Nvim::Batch::buf_set_lines(Buffer buffer, Integer start, Integer end, bool strict_indexing, const std::vector<std::string>& replacement) {
+    return BatchItem<void>(add(kBufSetLines, buffer, start, end, strict_indexing, replacement));
+}
+
+BatchItem<Integer> Nvim::Batch::buf_get_offset(Buffer buffer, Integer index) {
+    return BatchItem<Integer>(add(kBufGetOffset, buffer, index), decodeInteger);
+}
+
+BatchItem<Object> Nvim::Batch::buf_get_var(Buffer buffer, const std::string& name) {
+    return BatchItem<Object>(add(kBufGetVar, buffer, name), decodeObject);
+}
+
+BatchItem<Integer> Nvim::Batch::buf_get_changedtick(Buffer buffer) {
+    return BatchItem<Integer>(add(kBufGetChangedtick, buffer), decodeInteger);
+}
+
+BatchItem<std::vector<Dictionary>> Nvim::Batch::buf_get_keymap(Buffer buffer, const std::string& mode) {
+    return BatchItem<std::vector<Dictionary>>(add(kBufGetKeymap, buffer, mode), decodeArrayOfDictionary);
+}
+
+BatchItem<void> Nvim::Batch::buf_set_keymap(Buffer buffer, const std::string& mode, const std::string& lhs, const std::string& rhs, const Dictionary& opts) {
+    return BatchItem<void>(add(kBufSetKeymap, buffer, mode, lhs, rhs, opts));
+}
+
+BatchItem<void> Nvim::Batch::buf_del_keymap(Buffer buffer, const std::string& mode, const std::string& lhs) {
+    return BatchItem<void>(add(kBufDelKeymap, buffer, mode, lhs));
+}
+
+BatchItem<Dictionary> Nvim::Batch::buf_get_commands(Buffer buffer, const Dictionary& opts) {
+    return BatchItem<Dictionary>(add(kBufGetCommands, buffer, opts), decodeDictionary);
+}
+
+BatchItem<void> Nvim::Batch::buf_set_var(Buffer buffer, const std::string& name, const Object& value) {
+    return BatchItem<void>(add(kBufSetVar, buffer, name, value));
+}
+
+BatchItem<void> Nvim::Batch::buf_del_var(Buffer buffer, const std::string& name) {
+    return BatchItem<void>(add(kBufDelVar, buffer, name));
+}
+
+BatchItem<Object> Nvim::Batch::buf_get_option(Buffer buffer, const std::string& name) {
+    return BatchItem<Object>(add(kBufGetOption, buffer, name), decodeObject);
+}
+
+BatchItem<void> Nvim::Batch::buf_set_option(Buffer buffer, const std::string& name, const Object& value) {
+    return BatchItem<void>(add(kBufSetOption, buffer, name, value));
+}
+
+BatchItem<std::string> Nvim::Batch::buf_get_name(Buffer buffer) {
+    return BatchItem<std::string>(add(kBufGetName, buffer), decodeString);
+}
+
+BatchItem<void> Nvim::Batch::buf_set_name(Buffer buffer, const std::string& name) {
+    return BatchItem<void>(add(kBufSetName, buffer, name));
+}
+
+BatchItem<bool> Nvim::Batch::buf_is_loaded(Buffer buffer) {
+    return BatchItem<bool>(add(kBufIsLoaded, buffer), decodeBoolean);
+}
+
+BatchItem<bool> Nvim::Batch::buf_is_valid(Buffer buffer) {
+    return BatchItem<bool>(add(kBufIsValid, buffer), decodeBoolean);
+}
+
+BatchItem<std::vector<Integer>> Nvim::Batch::buf_get_mark(Buffer buffer, const std::string& name) {
+    return BatchItem<std::vector<Integer>>(add(kBufGetMark, buffer, name), decodeArrayOfInteger2);
+}
+
+BatchItem<Integer> Nvim::Batch::buf_add_highlight(Buffer buffer, Integer ns_id, const std::string& hl_group, Integer line, Integer col_start, Integer col_end) {
+    return BatchItem<Integer>(add(kBufAddHighlight, buffer, ns_id, hl_group, line, col_start, col_end), decodeInteger);
+}
+
+BatchItem<void> Nvim::Batch::buf_clear_namespace(Buffer buffer, Integer ns_id, Integer line_start, Integer line_end) {
+    return BatchItem<void>(add(kBufClearNamespace, buffer, ns_id, line_start, line_end));
+}
+
+BatchItem<void> Nvim::Batch::buf_clear_highlight(Buffer buffer, Integer ns_id, Integer line_start, Integer line_end) {
+    return BatchItem<void>(add(kBufClearHighlight, buffer, ns_id, line_start, line_end));
+}
+
+BatchItem<Integer> Nvim::Batch::buf_set_virtual_text(Buffer buffer, Integer ns_id, Integer line, const Array& chunks, const Dictionary& opts) {
+    return BatchItem<Integer>(add(kBufSetVirtualText, buffer, ns_id, line, chunks, opts), decodeInteger);
+}
+
+BatchItem<std::vector<Window>> Nvim::Batch::tabpage_list_wins(Tabpage tabpage) {
+    return BatchItem<std::vector<Window>>(add(kTabpageListWins, tabpage), decodeArrayOfWindow);
+}
+
+BatchItem<Object> Nvim::Batch::tabpage_get_var(Tabpage tabpage, const std::string& name) {
+    return BatchItem<Object>(add(kTabpageGetVar, tabpage, name), decodeObject);
+}
+
+BatchItem<void> Nvim::Batch::tabpage_set_var(Tabpage tabpage, const std::string& name, const Object& value) {
+    return BatchItem<void>(add(kTabpageSetVar, tabpage, name, value));
+}
+
+BatchItem<void> Nvim::Batch::tabpage_del_var(Tabpage tabpage, const std::string& name) {
+    return BatchItem<void>(add(kTabpageDelVar, tabpage, name));
+}
+
+BatchItem<Window> Nvim::Batch::tabpage_get_win(Tabpage tabpage) {
+    return BatchItem<Window>(add(kTabpageGetWin, tabpage), decodeWindow);
+}
+
+BatchItem<Integer> Nvim::Batch::tabpage_get_number(Tabpage tabpage) {
+    return BatchItem<Integer>(add(kTabpageGetNumber, tabpage), decodeInteger);
+}
+
+BatchItem<bool> Nvim::Batch::tabpage_is_valid(Tabpage tabpage) {
+    return BatchItem<bool>(add(kTabpageIsValid, tabpage), decodeBoolean);
+}
+
+BatchItem<void> Nvim::Batch::ui_attach(Integer width, Integer height, const Dictionary& options) {
+    return BatchItem<void>(add(kUiAttach, width, height, options));
+}
+
+BatchItem<void> Nvim::Batch::ui_detach() {
+    return BatchItem<void>(add(kUiDetach));
+}
+
+BatchItem<void> Nvim::Batch::ui_try_resize(Integer width, Integer height) {
+    return BatchItem<void>(add(kUiTryResize, width, height));
+}
+
+BatchItem<void> Nvim::Batch::ui_set_option(const std::string& name, const Object& value) {
+    return BatchItem<void>(add(kUiSetOption, name, value));
+}
+
+BatchItem<void> Nvim::Batch::ui_try_resize_grid(Integer grid, Integer width, Integer height) {
+    return BatchItem<void>(add(kUiTryResizeGrid, grid, width, height));
+}
+
+BatchItem<void> Nvim::Batch::ui_pum_set_height(Integer height) {
+    return BatchItem<void>(add(kUiPumSetHeight, height));
+}
+
+BatchItem<void> Nvim::Batch::command(const std::string& command) {
+    return BatchItem<void>(add(kCommand, command));
+}
+
+BatchItem<Dictionary> Nvim::Batch::get_hl_by_name(const std::string& name, bool rgb) {
+    return BatchItem<Dictionary>(add(kGetHlByName, name, rgb), decodeDictionary);
+}
+
+BatchItem<Dictionary> Nvim::Batch::get_hl_by_id(Integer hl_id, bool rgb) {
+    return BatchItem<Dictionary>(add(kGetHlById, hl_id, rgb), decodeDictionary);
+}
+
+BatchItem<void> Nvim::Batch::feedkeys(const std::string& keys, const std::string& mode, bool escape_csi) {
+    return BatchItem<void>(add(kFeedkeys, keys, mode, escape_csi));
+}
+
+BatchItem<Integer> Nvim::Batch::input(const std::string& keys) {
+    return BatchItem<Integer>(add(kInput, keys), decodeInteger);
+}
+
+BatchItem<void> Nvim::Batch::input_mouse(const std::string& button, const std::string& action, const std::string& modifier, Integer grid, Integer row, Integer col) {
+    return BatchItem<void>(add(kInputMouse, button, action, modifier, grid, row, col));
+}
+
+BatchItem<std::string> Nvim::Batch::replace_termcodes(const std::string& str, bool from_part, bool do_lt, bool special) {
+    return BatchItem<std::string>(add(kReplaceTermcodes, str, from_part, do_lt, special), decodeString);
+}
+
+BatchItem<std::string> Nvim::Batch::command_output(const std::string& command) {
+    return BatchItem<std::string>(add(kCommandOutput, command), decodeString);
+}
+
+BatchItem<Object> Nvim::Batch::eval(const std::string& expr) {
+    return BatchItem<Object>(add(kEval, expr), decodeObject);
+}
+
+BatchItem<Object> Nvim::Batch::execute_lua(const std::string& code, const Array& args) {
+    return BatchItem<Object>(add(kExecuteLua, code, args), decodeObject);
+}
+
+BatchItem<Object> Nvim::Batch::call_function(const std::string& fn, const Array& args) {
+    return BatchItem<Object>(add(kCallFunction, fn, args), decodeObject);
+}
+
+BatchItem<Object> Nvim::Batch::call_dict_function(const Object& dict, const std::string& fn, const Array& args) {
+    return BatchItem<Object>(add(kCallDictFunction, dict, fn, args), decodeObject);
+}
+
+BatchItem<Integer> Nvim::Batch::strwidth(const std::string& text) {
+    return BatchItem<Integer>(add(kStrwidth, text), decodeInteger);
+}
+
+BatchItem<std::vector<std::string>> Nvim::Batch::list_runtime_paths() {
+    return BatchItem<std::vector<std::string>>(add(kListRuntimePaths), decodeArrayOfString);
+}
+
+BatchItem<void> Nvim::Batch::set_current_dir(const std::string& dir) {
+    return BatchItem<void>(add(kSetCurrentDir, dir));
+}
+
+BatchItem<std::string> Nvim::Batch::get_current_line() {
+    return BatchItem<std::string>(add(kGetCurrentLine), decodeString);
+}
+
+BatchItem<void> Nvim::Batch::set_current_line(const std::string& line) {
+    return BatchItem<void>(add(kSetCurrentLine, line));
+}
+
+BatchItem<void> Nvim::Batch::del_current_line() {
+    return BatchItem<void>(add(kDelCurrentLine));
+}
+
+BatchItem<Object> Nvim::Batch::get_var(const std::string& name) {
+    return BatchItem<Object>(add(kGetVar, name), decodeObject);
+}
+
+BatchItem<void> Nvim::Batch::set_var(const std::string& name, const Object& value) {
+    return BatchItem<void>(add(kSetVar, name, value));
+}
+
+BatchItem<void> Nvim::Batch::del_var(const std::string& name) {
+    return BatchItem<void>(add(kDelVar, name));
+}
+
+BatchItem<Object> Nvim::Batch::get_vvar(const std::string& name) {
+    return BatchItem<Object>(add(kGetVvar, name), decodeObject);
+}
+
+BatchItem<void> Nvim::Batch::set_vvar(const std::string& name, const Object& value) {
+    return BatchItem<void>(add(kSetVvar, name, value));
+}
+
+BatchItem<Object> Nvim::Batch::get_option(const std::string& name) {
+    return BatchItem<Object>(add(kGetOption, name), decodeObject);
+}
+
+BatchItem<void> Nvim::Batch::set_option(const std::string& name, const Object& value) {
+    return BatchItem<void>(add(kSetOption, name, value));
+}
+
+BatchItem<void> Nvim::Batch::out_write(const std::string& str) {
+    return BatchItem<void>(add(kOutWrite, str));
+}
+
+BatchItem<void> Nvim::Batch::err_write(const std::string& str) {
+    return BatchItem<void>(add(kErrWrite, str));
+}
+
+BatchItem<void> Nvim::Batch::err_writeln(const std::string& str) {
+    return BatchItem<void>(add(kErrWriteln, str));
+}
+
+BatchItem<std::vector<Buffer>> Nvim::Batch::list_bufs() {
+    return BatchItem<std::vector<Buffer>>(add(kListBufs), decodeArrayOfBuffer);
+}
+
+BatchItem<Buffer> Nvim::Batch::get_current_buf() {
+    return BatchItem<Buffer>(add(kGetCurrentBuf), decodeBuffer);
+}
+
+BatchItem<void> Nvim::Batch::set_current_buf(Buffer buffer) {
+    return BatchItem<void>(add(kSetCurrentBuf, buffer));
+}
+
+BatchItem<std::vector<Window>> Nvim::Batch::list_wins() {
+    return BatchItem<std::vector<Window>>(add(kListWins), decodeArrayOfWindow);
+}
+
+BatchItem<Window> Nvim::Batch::get_current_win() {
+    return BatchItem<Window>(add(kGetCurrentWin), decodeWindow);
+}
+
+BatchItem<void> Nvim::Batch::set_current_win(Window window) {
+    return BatchItem<void>(add(kSetCurrentWin, window));
+}
+
+BatchItem<Buffer> Nvim::Batch::create_buf(bool listed, bool scratch) {
+    return BatchItem<Buffer>(add(kCreateBuf, listed, scratch), decodeBuffer);
+}
+
+BatchItem<Window> Nvim::Batch::open_win(Buffer buffer, bool enter, const Dictionary& config) {
+    return BatchItem<Window>(add(kOpenWin, buffer, enter, config), decodeWindow);
+}
+
+BatchItem<std::vector<Tabpage>> Nvim::Batch::list_tabpages() {
+    return BatchItem<std::vector<Tabpage>>(add(kListTabpages), decodeArrayOfTabpage);
+}
+
+BatchItem<Tabpage> Nvim::Batch::get_current_tabpage() {
+    return BatchItem<Tabpage>(add(kGetCurrentTabpage), decodeTabpage);
+}
+
+BatchItem<void> Nvim::Batch::set_current_tabpage(Tabpage tabpage) {
+    return BatchItem<void>(add(kSetCurrentTabpage, tabpage));
+}
+
+BatchItem<Integer> Nvim::Batch::create_namespace(const std::string& name) {
+    return BatchItem<Integer>(add(kCreateNamespace, name), decodeInteger);
+}
+
+BatchItem<Dictionary> Nvim::Batch::get_namespaces() {
+    return BatchItem<Dictionary>(add(kGetNamespaces), decodeDictionary);
+}
+
+BatchItem<bool> Nvim::Batch::paste(const std::string& data, bool crlf, Integer phase) {
+    return BatchItem<bool>(add(kPaste, data, crlf, phase), decodeBoolean);
+}
+
+BatchItem<void> Nvim::Batch::put(const std::vector<std::string>& lines, const std::string& type, bool after, bool follow) {
+    return BatchItem<void>(add(kPut, lines, type, after, follow));
+}
+
+BatchItem<void> Nvim::Batch::subscribe(const std::string& event) {
+    return BatchItem<void>(add(kSubscribe, event));
+}
+
+BatchItem<void> Nvim::Batch::unsubscribe(const std::string& event) {
+    return BatchItem<void>(add(kUnsubscribe, event));
+}
+
+BatchItem<Integer> Nvim::Batch::get_color_by_name(const std::string& name) {
+    return BatchItem<Integer>(add(kGetColorByName, name), decodeInteger);
+}
+
+BatchItem<Dictionary> Nvim::Batch::get_color_map() {
+    return BatchItem<Dictionary>(add(kGetColorMap), decodeDictionary);
+}
+
+BatchItem<Dictionary> Nvim::Batch::get_context(const Dictionary& opts) {
+    return BatchItem<Dictionary>(add(kGetContext, opts), decodeDictionary);
+}
+
+BatchItem<Object> Nvim::Batch::load_context(const Dictionary& dict) {
+    return BatchItem<Object>(add(kLoadContext, dict), decodeObject);
+}
+
+BatchItem<Dictionary> Nvim::Batch::get_mode() {
+    return BatchItem<Dictionary>(add(kGetMode), decodeDictionary);
+}
+
+BatchItem<std::vector<Dictionary>> Nvim::Batch::get_keymap(const std::string& mode) {
+    return BatchItem<std::vector<Dictionary>>(add(kGetKeymap, mode), decodeArrayOfDictionary);
+}
+
+BatchItem<void> Nvim::Batch::set_keymap(const std::string& mode, const std::string& lhs, const std::string& rhs, const Dictionary& opts) {
+    return BatchItem<void>(add(kSetKeymap, mode, lhs, rhs, opts));
+}
+
+BatchItem<void> Nvim::Batch::del_keymap(const std::string& mode, const std::string& lhs) {
+    return BatchItem<void>(add(kDelKeymap, mode, lhs));
+}
+
+BatchItem<Dictionary> Nvim::Batch::get_commands(const Dictionary& opts) {
+    return BatchItem<Dictionary>(add(kGetCommands, opts), decodeDictionary);
+}
+
+BatchItem<Array> Nvim::Batch::get_api_info() {
+    return BatchItem<Array>(add(kGetApiInfo), decodeArray);
+}
+
+BatchItem<void> Nvim::Batch::set_client_info(const std::string& name, const Dictionary& version, const std::string& type, const Dictionary& methods, const Dictionary& attributes) {
+    return BatchItem<void>(add(kSetClientInfo, name, version, type, methods, attributes));
+}
+
+BatchItem<Dictionary> Nvim::Batch::get_chan_info(Integer chan) {
+    return BatchItem<Dictionary>(add(kGetChanInfo, chan), decodeDictionary);
+}
+
+BatchItem<Array> Nvim::Batch::list_chans() {
+    return BatchItem<Array>(add(kListChans), decodeArray);
+}
+
+BatchItem<Array> Nvim::Batch::call_atomic(const Array& calls) {
+    return BatchItem<Array>(add(kCallAtomic, calls), decodeArray);
+}
+
+BatchItem<Dictionary> Nvim::Batch::parse_expression(const std::string& expr, const std::string& flags, bool highlight) {
+    return BatchItem<Dictionary>(add(kParseExpression, expr, flags, highlight), decodeDictionary);
+}
+
+BatchItem<Array> Nvim::Batch::list_uis() {
+    return BatchItem<Array>(add(kListUis), decodeArray);
+}
+
+BatchItem<Array> Nvim::Batch::get_proc_children(Integer pid) {
+    return BatchItem<Array>(add(kGetProcChildren, pid), decodeArray);
+}
+
+BatchItem<Object> Nvim::Batch::get_proc(Integer pid) {
+    return BatchItem<Object>(add(kGetProc, pid), decodeObject);
+}
+
+BatchItem<void> Nvim::Batch::select_popupmenu_item(Integer item, bool insert, bool finish, const Dictionary& opts) {
+    return BatchItem<void>(add(kSelectPopupmenuItem, item, insert, finish, opts));
+}
+
+BatchItem<Buffer> Nvim::Batch::win_get_buf(Window window) {
+    return BatchItem<Buffer>(add(kWinGetBuf, window), decodeBuffer);
+}
+
+BatchItem<void> Nvim::Batch::win_set_buf(Window window, Buffer buffer) {
+    return BatchItem<void>(add(kWinSetBuf, window, buffer));
+}
+
+BatchItem<std::vector<Integer>> Nvim::Batch::win_get_cursor(Window window) {
+    return BatchItem<std::vector<Integer>>(add(kWinGetCursor, window), decodeArrayOfInteger2);
+}
+
+BatchItem<void> Nvim::Batch::win_set_cursor(Window window, const std::vector<Integer>& pos) {
+    return BatchItem<void>(add(kWinSetCursor, window, pos));
+}
+
+BatchItem<Integer> Nvim::Batch::win_get_height(Window window) {
+    return BatchItem<Integer>(add(kWinGetHeight, window), decodeInteger);
+}
+
+BatchItem<void> Nvim::Batch::win_set_height(Window window, Integer height) {
+    return BatchItem<void>(add(kWinSetHeight, window, height));
+}
+
+BatchItem<Integer> Nvim::Batch::win_get_width(Window window) {
+    return BatchItem<Integer>(add(kWinGetWidth, window), decodeInteger);
+}
+
+BatchItem<void> Nvim::Batch::win_set_width(Window window, Integer width) {
+    return BatchItem<void>(add(kWinSetWidth, window, width));
+}
+
+BatchItem<Object> Nvim::Batch::win_get_var(Window window, const std::string& name) {
+    return BatchItem<Object>(add(kWinGetVar, window, name), decodeObject);
+}
+
+BatchItem<void> Nvim::Batch::win_set_var(Window window, const std::string& name, const Object& value) {
+    return BatchItem<void>(add(kWinSetVar, window, name, value));
+}
+
+BatchItem<void> Nvim::Batch::win_del_var(Window window, const std::string& name) {
+    return BatchItem<void>(add(kWinDelVar, window, name));
+}
+
+BatchItem<Object> Nvim::Batch::win_get_option(Window window, const std::string& name) {
+    return BatchItem<Object>(add(kWinGetOption, window, name), decodeObject);
+}
+
+BatchItem<void> Nvim::Batch::win_set_option(Window window, const std::string& name, const Object& value) {
+    return BatchItem<void>(add(kWinSetOption, window, name, value));
+}
+
+BatchItem<std::vector<Integer>> Nvim::Batch::win_get_position(Window window) {
+    return BatchItem<std::vector<Integer>>(add(kWinGetPosition, window), decodeArrayOfInteger2);
+}
+
+BatchItem<Tabpage> Nvim::Batch::win_get_tabpage(Window window) {
+    return BatchItem<Tabpage>(add(kWinGetTabpage, window), decodeTabpage);
+}
+
+BatchItem<Integer> Nvim::Batch::win_get_number(Window window) {
+    return BatchItem<Integer>(add(kWinGetNumber, window), decodeInteger);
+}
+
+BatchItem<bool> Nvim::Batch::win_is_valid(Window window) {
+    return BatchItem<bool>(add(kWinIsValid, window), decodeBoolean);
+}
+
+BatchItem<void> Nvim::Batch::win_set_config(Window window, const Dictionary& config) {
+    return BatchItem<void>(add(kWinSetConfig, window, config));
+}
+
+BatchItem<Dictionary> Nvim::Batch::win_get_config(Window window) {
+    return BatchItem<Dictionary>(add(kWinGetConfig, window), decodeDictionary);
+}
+
+BatchItem<void> Nvim::Batch::win_close(Window window, bool force) {
+    return BatchItem<void>(add(kWinClose, window, force));
 }
 
 } //namespace nvim
\ No newline at end of file
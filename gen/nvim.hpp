@@ -9,10 +9,145 @@ namespace nvim {
 
 class Nvim {
 public:
+    /// Typed calls recorded for one nvim_call_atomic request.
+    class Batch : public BatchBase {
+    public:
+        explicit Batch(NvimRPC *client) : BatchBase(client) {}
+
+        BatchItem<Integer> buf_line_count(Buffer buffer);
+        BatchItem<bool> buf_attach(Buffer buffer, bool send_buffer, const Dictionary& opts);
+        BatchItem<bool> buf_detach(Buffer buffer);
+        BatchItem<std::vector<std::string>> buf_get_lines(Buffer buffer, Integer start, Integer end, bool strict_indexing);
+        BatchItem<void> buf_set_lines(Buffer buffer, Integer start, Integer end, bool strict_indexing, const std::vector<std::string>& replacement);
+        BatchItem<Integer> buf_get_offset(Buffer buffer, Integer index);
+        BatchItem<Object> buf_get_var(Buffer buffer, const std::string& name);
+        BatchItem<Integer> buf_get_changedtick(Buffer buffer);
+        BatchItem<std::vector<Dictionary>> buf_get_keymap(Buffer buffer, const std::string& mode);
+        BatchItem<void> buf_set_keymap(Buffer buffer, const std::string& mode, const std::string& lhs, const std::string& rhs, const Dictionary& opts);
+        BatchItem<void> buf_del_keymap(Buffer buffer, const std::string& mode, const std::string& lhs);
+        BatchItem<Dictionary> buf_get_commands(Buffer buffer, const Dictionary& opts);
+        BatchItem<void> buf_set_var(Buffer buffer, const std::string& name, const Object& value);
+        BatchItem<void> buf_del_var(Buffer buffer, const std::string& name);
+        BatchItem<Object> buf_get_option(Buffer buffer, const std::string& name);
+        BatchItem<void> buf_set_option(Buffer buffer, const std::string& name, const Object& value);
+        BatchItem<std::string> buf_get_name(Buffer buffer);
+        BatchItem<void> buf_set_name(Buffer buffer, const std::string& name);
+        BatchItem<bool> buf_is_loaded(Buffer buffer);
+        BatchItem<bool> buf_is_valid(Buffer buffer);
+        BatchItem<std::vector<Integer>> buf_get_mark(Buffer buffer, const std::string& name);
+        BatchItem<Integer> buf_add_highlight(Buffer buffer, Integer ns_id, const std::string& hl_group, Integer line, Integer col_start, Integer col_end);
+        BatchItem<void> buf_clear_namespace(Buffer buffer, Integer ns_id, Integer line_start, Integer line_end);
+        BatchItem<void> buf_clear_highlight(Buffer buffer, Integer ns_id, Integer line_start, Integer line_end);
+        BatchItem<Integer> buf_set_virtual_text(Buffer buffer, Integer ns_id, Integer line, const Array& chunks, const Dictionary& opts);
+        BatchItem<std::vector<Window>> tabpage_list_wins(Tabpage tabpage);
+        BatchItem<Object> tabpage_get_var(Tabpage tabpage, const std::string& name);
+        BatchItem<void> tabpage_set_var(Tabpage tabpage, const std::string& name, const Object& value);
+        BatchItem<void> tabpage_del_var(Tabpage tabpage, const std::string& name);
+        BatchItem<Window> tabpage_get_win(Tabpage tabpage);
+        BatchItem<Integer> tabpage_get_number(Tabpage tabpage);
+        BatchItem<bool> tabpage_is_valid(Tabpage tabpage);
+        BatchItem<void> ui_attach(Integer width, Integer height, const Dictionary& options);
+        BatchItem<void> ui_detach();
+        BatchItem<void> ui_try_resize(Integer width, Integer height);
+        BatchItem<void> ui_set_option(const std::string& name, const Object& value);
+        BatchItem<void> ui_try_resize_grid(Integer grid, Integer width, Integer height);
+        BatchItem<void> ui_pum_set_height(Integer height);
+        BatchItem<void> command(const std::string& command);
+        BatchItem<Dictionary> get_hl_by_name(const std::string& name, bool rgb);
+        BatchItem<Dictionary> get_hl_by_id(Integer hl_id, bool rgb);
+        BatchItem<void> feedkeys(const std::string& keys, const std::string& mode, bool escape_csi);
+        BatchItem<Integer> input(const std::string& keys);
+        BatchItem<void> input_mouse(const std::string& button, const std::string& action, const std::string& modifier, Integer grid, Integer row, Integer col);
+        BatchItem<std::string> replace_termcodes(const std::string& str, bool from_part, bool do_lt, bool special);
+        BatchItem<std::string> command_output(const std::string& command);
+        BatchItem<Object> eval(const std::string& expr);
+        BatchItem<Object> execute_lua(const std::string& code, const Array& args);
+        BatchItem<Object> call_function(const std::string& fn, const Array& args);
+        BatchItem<Object> call_dict_function(const Object& dict, const std::string& fn, const Array& args);
+        BatchItem<Integer> strwidth(const std::string& text);
+        BatchItem<std::vector<std::string>> list_runtime_paths();
+        BatchItem<void> set_current_dir(const std::string& dir);
+        BatchItem<std::string> get_current_line();
+        BatchItem<void> set_current_line(const std::string& line);
+        BatchItem<void> del_current_line();
+        BatchItem<Object> get_var(const std::string& name);
+        BatchItem<void> set_var(const std::string& name, const Object& value);
+        BatchItem<void> del_var(const std::string& name);
+        BatchItem<Object> get_vvar(const std::string& name);
+        BatchItem<void> set_vvar(const std::string& name, const Object& value);
+        BatchItem<Object> get_option(const std::string& name);
+        BatchItem<void> set_option(const std::string& name, const Object& value);
+        BatchItem<void> out_write(const std::string& str);
+        BatchItem<void> err_write(const std::string& str);
+        BatchItem<void> err_writeln(const std::string& str);
+        BatchItem<std::vector<Buffer>> list_bufs();
+        BatchItem<Buffer> get_current_buf();
+        BatchItem<void> set_current_buf(Buffer buffer);
+        BatchItem<std::vector<Window>> list_wins();
+        BatchItem<Window> get_current_win();
+        BatchItem<void> set_current_win(Window window);
+        BatchItem<Buffer> create_buf(bool listed, bool scratch);
+        BatchItem<Window> open_win(Buffer buffer, bool enter, const Dictionary& config);
+        BatchItem<std::vector<Tabpage>> list_tabpages();
+        BatchItem<Tabpage> get_current_tabpage();
+        BatchItem<void> set_current_tabpage(Tabpage tabpage);
+        BatchItem<Integer> create_namespace(const std::string& name);
+        BatchItem<Dictionary> get_namespaces();
+        BatchItem<bool> paste(const std::string& data, bool crlf, Integer phase);
+        BatchItem<void> put(const std::vector<std::string>& lines, const std::string& type, bool after, bool follow);
+        BatchItem<void> subscribe(const std::string& event);
+        BatchItem<void> unsubscribe(const std::string& event);
+        BatchItem<Integer> get_color_by_name(const std::string& name);
+        BatchItem<Dictionary> get_color_map();
+        BatchItem<Dictionary> get_context(const Dictionary& opts);
+        BatchItem<Object> load_context(const Dictionary& dict);
+        BatchItem<Dictionary> get_mode();
+        BatchItem<std::vector<Dictionary>> get_keymap(const std::string& mode);
+        BatchItem<void> set_keymap(const std::string& mode, const std::string& lhs, const std::string& rhs, const Dictionary& opts);
+        BatchItem<void> del_keymap(const std::string& mode, const std::string& lhs);
+        BatchItem<Dictionary> get_commands(const Dictionary& opts);
+        BatchItem<Array> get_api_info();
+        BatchItem<void> set_client_info(const std::string& name, const Dictionary& version, const std::string& type, const Dictionary& methods, const Dictionary& attributes);
+        BatchItem<Dictionary> get_chan_info(Integer chan);
+        BatchItem<Array> list_chans();
+        BatchItem<Array> call_atomic(const Array& calls);
+        BatchItem<Dictionary> parse_expression(const std::string& expr, const std::string& flags, bool highlight);
+        BatchItem<Array> list_uis();
+        BatchItem<Array> get_proc_children(Integer pid);
+        BatchItem<Object> get_proc(Integer pid);
+        BatchItem<void> select_popupmenu_item(Integer item, bool insert, bool finish, const Dictionary& opts);
+        BatchItem<Buffer> win_get_buf(Window window);
+        BatchItem<void> win_set_buf(Window window, Buffer buffer);
+        BatchItem<std::vector<Integer>> win_get_cursor(Window window);
+        BatchItem<void> win_set_cursor(Window window, const std::vector<Integer>& pos);
+        BatchItem<Integer> win_get_height(Window window);
+        BatchItem<void> win_set_height(Window window, Integer height);
+        BatchItem<Integer> win_get_width(Window window);
+        BatchItem<void> win_set_width(Window window, Integer width);
+        BatchItem<Object> win_get_var(Window window, const std::string& name);
+        BatchItem<void> win_set_var(Window window, const std::string& name, const Object& value);
+        BatchItem<void> win_del_var(Window window, const std::string& name);
+        BatchItem<Object> win_get_option(Window window, const std::string& name);
+        BatchItem<void> win_set_option(Window window, const std::string& name, const Object& value);
+        BatchItem<std::vector<Integer>> win_get_position(Window window);
+        BatchItem<Tabpage> win_get_tabpage(Window window);
+        BatchItem<Integer> win_get_number(Window window);
+        BatchItem<bool> win_is_valid(Window window);
+        BatchItem<void> win_set_config(Window window, const Dictionary& config);
+        BatchItem<Dictionary> win_get_config(Window window);
+        BatchItem<void> win_close(Window window, bool force);
+    };
+
+    Batch batch();
+
     void connect_tcp(const std::string &host,
             const std::string &service, double timeout_sec = 1.0);
     void connect_pipe(const std::string &name,
             double timeout_sec = 1.0);
+    /// Server started by nvim with jobstart(cmd, {'rpc': v:true}).
+    void connect_stdio();
+    /// A connection accepted by the daemon.
+    void connect_fd(int fd);
 
 
     Integer buf_line_count(Buffer buffer);
@@ -259,6 +394,128 @@ public:
     void async_win_set_config(Window window, const Dictionary& config);
     void async_win_get_config(Window window);
     void async_win_close(Window window, bool force);
+    Future<Integer> future_buf_line_count(Buffer buffer);
+    Future<bool> future_buf_attach(Buffer buffer, bool send_buffer, const Dictionary& opts);
+    Future<bool> future_buf_detach(Buffer buffer);
+    Future<std::vector<std::string>> future_buf_get_lines(Buffer buffer, Integer start, Integer end, bool strict_indexing);
+    Future<void> future_buf_set_lines(Buffer buffer, Integer start, Integer end, bool strict_indexing, const std::vector<std::string>& replacement);
+    Future<Integer> future_buf_get_offset(Buffer buffer, Integer index);
+    Future<Object> future_buf_get_var(Buffer buffer, const std::string& name);
+    Future<Integer> future_buf_get_changedtick(Buffer buffer);
+    Future<std::vector<Dictionary>> future_buf_get_keymap(Buffer buffer, const std::string& mode);
+    Future<void> future_buf_set_keymap(Buffer buffer, const std::string& mode, const std::string& lhs, const std::string& rhs, const Dictionary& opts);
+    Future<void> future_buf_del_keymap(Buffer buffer, const std::string& mode, const std::string& lhs);
+    Future<Dictionary> future_buf_get_commands(Buffer buffer, const Dictionary& opts);
+    Future<void> future_buf_set_var(Buffer buffer, const std::string& name, const Object& value);
+    Future<void> future_buf_del_var(Buffer buffer, const std::string& name);
+    Future<Object> future_buf_get_option(Buffer buffer, const std::string& name);
+    Future<void> future_buf_set_option(Buffer buffer, const std::string& name, const Object& value);
+    Future<std::string> future_buf_get_name(Buffer buffer);
+    Future<void> future_buf_set_name(Buffer buffer, const std::string& name);
+    Future<bool> future_buf_is_loaded(Buffer buffer);
+    Future<bool> future_buf_is_valid(Buffer buffer);
+    Future<std::vector<Integer>> future_buf_get_mark(Buffer buffer, const std::string& name);
+    Future<Integer> future_buf_add_highlight(Buffer buffer, Integer ns_id, const std::string& hl_group, Integer line, Integer col_start, Integer col_end);
+    Future<void> future_buf_clear_namespace(Buffer buffer, Integer ns_id, Integer line_start, Integer line_end);
+    Future<void> future_buf_clear_highlight(Buffer buffer, Integer ns_id, Integer line_start, Integer line_end);
+    Future<Integer> future_buf_set_virtual_text(Buffer buffer, Integer ns_id, Integer line, const Array& chunks, const Dictionary& opts);
+    Future<std::vector<Window>> future_tabpage_list_wins(Tabpage tabpage);
+    Future<Object> future_tabpage_get_var(Tabpage tabpage, const std::string& name);
+    Future<void> future_tabpage_set_var(Tabpage tabpage, const std::string& name, const Object& value);
+    Future<void> future_tabpage_del_var(Tabpage tabpage, const std::string& name);
+    Future<Window> future_tabpage_get_win(Tabpage tabpage);
+    Future<Integer> future_tabpage_get_number(Tabpage tabpage);
+    Future<bool> future_tabpage_is_valid(Tabpage tabpage);
+    Future<void> future_ui_attach(Integer width, Integer height, const Dictionary& options);
+    Future<void> future_ui_detach();
+    Future<void> future_ui_try_resize(Integer width, Integer height);
+    Future<void> future_ui_set_option(const std::string& name, const Object& value);
+    Future<void> future_ui_try_resize_grid(Integer grid, Integer width, Integer height);
+    Future<void> future_ui_pum_set_height(Integer height);
+    Future<void> future_command(const std::string& command);
+    Future<Dictionary> future_get_hl_by_name(const std::string& name, bool rgb);
+    Future<Dictionary> future_get_hl_by_id(Integer hl_id, bool rgb);
+    Future<void> future_feedkeys(const std::string& keys, const std::string& mode, bool escape_csi);
+    Future<Integer> future_input(const std::string& keys);
+    Future<void> future_input_mouse(const std::string& button, const std::string& action, const std::string& modifier, Integer grid, Integer row, Integer col);
+    Future<std::string> future_replace_termcodes(const std::string& str, bool from_part, bool do_lt, bool special);
+    Future<std::string> future_command_output(const std::string& command);
+    Future<Object> future_eval(const std::string& expr);
+    Future<Object> future_execute_lua(const std::string& code, const Array& args);
+    Future<Object> future_call_function(const std::string& fn, const Array& args);
+    Future<Object> future_call_dict_function(const Object& dict, const std::string& fn, const Array& args);
+    Future<Integer> future_strwidth(const std::string& text);
+    Future<std::vector<std::string>> future_list_runtime_paths();
+    Future<void> future_set_current_dir(const std::string& dir);
+    Future<std::string> future_get_current_line();
+    Future<void> future_set_current_line(const std::string& line);
+    Future<void> future_del_current_line();
+    Future<Object> future_get_var(const std::string& name);
+    Future<void> future_set_var(const std::string& name, const Object& value);
+    Future<void> future_del_var(const std::string& name);
+    Future<Object> future_get_vvar(const std::string& name);
+    Future<void> future_set_vvar(const std::string& name, const Object& value);
+    Future<Object> future_get_option(const std::string& name);
+    Future<void> future_set_option(const std::string& name, const Object& value);
+    Future<void> future_out_write(const std::string& str);
+    Future<void> future_err_write(const std::string& str);
+    Future<void> future_err_writeln(const std::string& str);
+    Future<std::vector<Buffer>> future_list_bufs();
+    Future<Buffer> future_get_current_buf();
+    Future<void> future_set_current_buf(Buffer buffer);
+    Future<std::vector<Window>> future_list_wins();
+    Future<Window> future_get_current_win();
+    Future<void> future_set_current_win(Window window);
+    Future<Buffer> future_create_buf(bool listed, bool scratch);
+    Future<Window> future_open_win(Buffer buffer, bool enter, const Dictionary& config);
+    Future<std::vector<Tabpage>> future_list_tabpages();
+    Future<Tabpage> future_get_current_tabpage();
+    Future<void> future_set_current_tabpage(Tabpage tabpage);
+    Future<Integer> future_create_namespace(const std::string& name);
+    Future<Dictionary> future_get_namespaces();
+    Future<bool> future_paste(const std::string& data, bool crlf, Integer phase);
+    Future<void> future_put(const std::vector<std::string>& lines, const std::string& type, bool after, bool follow);
+    Future<void> future_subscribe(const std::string& event);
+    Future<void> future_unsubscribe(const std::string& event);
+    Future<Integer> future_get_color_by_name(const std::string& name);
+    Future<Dictionary> future_get_color_map();
+    Future<Dictionary> future_get_context(const Dictionary& opts);
+    Future<Object> future_load_context(const Dictionary& dict);
+    Future<Dictionary> future_get_mode();
+    Future<std::vector<Dictionary>> future_get_keymap(const std::string& mode);
+    Future<void> future_set_keymap(const std::string& mode, const std::string& lhs, const std::string& rhs, const Dictionary& opts);
+    Future<void> future_del_keymap(const std::string& mode, const std::string& lhs);
+    Future<Dictionary> future_get_commands(const Dictionary& opts);
+    Future<Array> future_get_api_info();
+    Future<void> future_set_client_info(const std::string& name, const Dictionary& version, const std::string& type, const Dictionary& methods, const Dictionary& attributes);
+    Future<Dictionary> future_get_chan_info(Integer chan);
+    Future<Array> future_list_chans();
+    Future<Array> future_call_atomic(const Array& calls);
+    Future<Dictionary> future_parse_expression(const std::string& expr, const std::string& flags, bool highlight);
+    Future<Array> future_list_uis();
+    Future<Array> future_get_proc_children(Integer pid);
+    Future<Object> future_get_proc(Integer pid);
+    Future<void> future_select_popupmenu_item(Integer item, bool insert, bool finish, const Dictionary& opts);
+    Future<Buffer> future_win_get_buf(Window window);
+    Future<void> future_win_set_buf(Window window, Buffer buffer);
+    Future<std::vector<Integer>> future_win_get_cursor(Window window);
+    Future<void> future_win_set_cursor(Window window, const std::vector<Integer>& pos);
+    Future<Integer> future_win_get_height(Window window);
+    Future<void> future_win_set_height(Window window, Integer height);
+    Future<Integer> future_win_get_width(Window window);
+    Future<void> future_win_set_width(Window window, Integer width);
+    Future<Object> future_win_get_var(Window window, const std::string& name);
+    Future<void> future_win_set_var(Window window, const std::string& name, const Object& value);
+    Future<void> future_win_del_var(Window window, const std::string& name);
+    Future<Object> future_win_get_option(Window window, const std::string& name);
+    Future<void> future_win_set_option(Window window, const std::string& name, const Object& value);
+    Future<std::vector<Integer>> future_win_get_position(Window window);
+    Future<Tabpage> future_win_get_tabpage(Window window);
+    Future<Integer> future_win_get_number(Window window);
+    Future<bool> future_win_is_valid(Window window);
+    Future<void> future_win_set_config(Window window, const Dictionary& config);
+    Future<Dictionary> future_win_get_config(Window window);
+    Future<void> future_win_close(Window window, bool force);
 
 public:
     NvimRPC client_;
@@ -51,6 +51,41 @@ def convert_type_to_native(nvim_t, enable_ref_op, const_ref=True, ref=False):
     #TODO: implement error handler
     #return nvim_t
 
+def packed_method(name):
+    """ C string literal of the msgpack str encoding of name, and its size """
+    packed = msgpack.packb(name, use_bin_type=True)
+    header = packed[:len(packed) - len(name.encode())]
+    literal = '"%s" "%s"' % (''.join('\\x%02x' % b for b in header), name)
+    return literal, len(packed)
+
+def constant_name(short_name):
+    return 'k' + ''.join(w.capitalize() for w in short_name.split('_'))
+
+def make_decoder(nvim_t, types, decoders):
+    """ Register the response decoder of nvim_t (element types first), return its name """
+    name = 'decode' + re.sub(r'[^0-9A-Za-z]', '', nvim_t)
+    if name in decoders:
+        return name
+
+    obj = re.match(r'ArrayOf\(\s*(\w+)\s*(,\s*\d+\s*)?\)', nvim_t)
+    if obj:
+        body = 'detail::decode_array(obj, res, %s);' % make_decoder(obj.groups()[0], types, decoders)
+    elif nvim_t in types:
+        # Buffer, Window, Tabpage: EXT objects of the type id nvim reports
+        body = 'detail::decode_handle(obj, %d, res);' % types[nvim_t]['id']
+    elif nvim_t == 'Integer':
+        body = 'detail::decode_integer(obj, res);'
+    elif nvim_t == 'Boolean':
+        body = 'detail::decode_bool(obj, res);'
+    elif nvim_t == 'String':
+        body = 'detail::decode_string(obj, res);'
+    else:
+        # Object, Array, Dictionary hold variants anyway
+        body = 'obj.convert(res);'
+
+    decoders[name] = {'name': name, 'type': convert_type_to_native(nvim_t, False), 'body': body}
+    return name
+
 def main():
     env = Environment(loader=FileSystemLoader('templates', encoding='utf8'))
 
@@ -58,6 +93,8 @@ def main():
     unpacked_api = msgpack.unpackb(api_info, raw=False)
 
 # generate nvim.hpp
+    types = unpacked_api.get('types', {})
+    decoders = {}
     functions = []
     for f in unpacked_api['functions']:
         if 'deprecated_since' in f and f['deprecated_since']<=3:
@@ -68,11 +105,15 @@ def main():
         #     continue
         d['name'] = f['name']
         d['short_name'] = f['name'][5:] if f['name'].startswith('nvim_') else f['name']
+        d['const_name'] = constant_name(d['short_name'])
+        d['packed'], d['packed_size'] = packed_method(f['name'])
 
         try:
             d['return'] = convert_type_to_native(f['return_type'], False)
             d['args'] = [{'type': convert_type_to_native(arg[0], True),
                           'name': arg[1]} for arg in f['parameters']]
+            if f['return_type'] != 'void':
+                d['decoder'] = make_decoder(f['return_type'], types, decoders)
             functions.append(d)
         except InvalidType as e:
             print("invalid function = " + str(f))
@@ -83,7 +124,7 @@ def main():
         f.write(api)
 
     tplcpp = env.get_template('nvim.cpp')
-    apicpp = tplcpp.render({'functions': functions})
+    apicpp = tplcpp.render({'functions': functions, 'decoders': decoders.values()})
     with open(os.path.join("./gen", "nvim.cpp"), 'w') as f:
         f.write(apicpp)
 
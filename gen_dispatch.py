@@ -0,0 +1,125 @@
+#!/usr/bin/python3
+# -*- coding: utf-8 -*-
+
+# Generates gen/dispatch.{hpp,cpp} from tree_rpc.json, the schema of what
+# nvim sends to the server:
+#   requests, notifications  methods and their positional arguments
+#   functions                callbacks of the "function" notification
+#   actions                  action name and the Tree member running it
+# An argument is [type, name], type being String, Integer, Boolean, Array,
+# Dictionary, Object, Context or a list of arguments for a nested array. "value"
+# instead of "args" is a single argument that is not wrapped in an array.
+
+from jinja2 import Environment, FileSystemLoader
+import json, os
+
+FIELD_T = {
+    'String': ('boost::string_ref', 'get_string'),
+    'Integer': ('int64_t', 'get_integer'),
+    'Boolean': ('bool', 'get_boolean'),
+    'Array': ('nvim::ObjectRef', 'get_array'),
+    'Dictionary': ('nvim::ObjectRef', 'get_dictionary'),
+    'Object': ('nvim::ObjectRef', 'get_object'),
+    # tree::Context, compact (an Array) or full (a Dictionary)
+    'Context': ('nvim::ObjectRef', 'get_context'),
+}
+
+def camel_name(name):
+    return ''.join(w.capitalize() for w in name.split('_'))
+
+def constant_name(name):
+    return 'k' + camel_name(name)
+
+def fnv1a(s, seed):
+    """ Same as rpc::hash() in templates/dispatch.hpp """
+    h = 2166136261 ^ seed
+    for b in s.encode():
+        h = ((h ^ b) * 16777619) & 0xffffffff
+    return h
+
+def perfect_hash(names):
+    """ (seed, slots): slots[fnv1a(name, seed) & (len(slots) - 1)] is the index of name """
+    size = 1
+    while size < len(names):
+        size *= 2
+    while True:
+        for seed in range(100000):
+            slots = [-1] * size
+            for i, name in enumerate(names):
+                slot = fnv1a(name, seed) & (size - 1)
+                if slots[slot] >= 0:
+                    break
+                slots[slot] = i
+            else:
+                return seed, slots
+        size *= 2
+
+def make_table(kind, names):
+    seed, slots = perfect_hash(names)
+    return {'kind': kind, 'seed': seed, 'slots': slots,
+            'names': [{'name': n, 'const_name': constant_name(n)} for n in names]}
+
+def declare(args, indent):
+    """ Member declarations, nested arrays as nested structs """
+    lines = []
+    for t, name in args:
+        if isinstance(t, list):
+            lines.append('%sstruct %s {' % (indent, camel_name(name)))
+            lines += declare(t, indent + '    ')
+            lines.append('%s} %s;' % (indent, name))
+        else:
+            lines.append('%s%s %s;' % (indent, FIELD_T[t][0], name))
+    return lines
+
+def decode(args, src, prefix, where, depth):
+    """ Statements decoding the array src into the members """
+    a = 'a%d' % depth
+    lines = ['const msgpack::object *%s = tuple(%s, %d, "%s");' % (a, src, len(args), where)]
+    for i, (t, name) in enumerate(args):
+        if isinstance(t, list):
+            lines += decode(t, '%s[%d]' % (a, i), prefix + name + '.', where + '.' + name, depth + 1)
+        else:
+            lines.append('%s(%s[%d], %s%s, "%s", "%s");' % (FIELD_T[t][1], a, i, prefix, name, where, name))
+    return lines
+
+def make_struct(prefix, m):
+    d = {'name': m['name'], 'struct': prefix + camel_name(m['name']) + 'Args',
+         'doc': m.get('doc', [])}
+    if 'value' in m:
+        t, name = m['value']
+        d['members'] = declare([m['value']], '    ')
+        d['decode'] = ['%s(msg, %s, "%s", "%s");' % (FIELD_T[t][1], name, m['name'], name)]
+        d['signature'] = name
+    elif m['args']:
+        d['members'] = declare(m['args'], '    ')
+        d['decode'] = decode(m['args'], 'msg', '', m['name'], 0)
+        d['signature'] = '[%s]' % ', '.join(name for t, name in m['args'])
+    else:
+        return None
+    return d
+
+def main():
+    env = Environment(loader=FileSystemLoader('templates', encoding='utf8'),
+                      keep_trailing_newline=True)
+    with open('tree_rpc.json') as f:
+        schema = json.load(f)
+
+    tables = [
+        make_table('Request', [m['name'] for m in schema['requests']]),
+        make_table('Notification', [m['name'] for m in schema['notifications']]),
+        make_table('Function', [m['name'] for m in schema['functions']]),
+        make_table('Action', [a[0] for a in schema['actions']]),
+    ]
+    structs = [s for s in
+               [make_struct('', m) for m in schema['requests'] + schema['notifications']] +
+               [make_struct('Function', m) for m in schema['functions']] if s]
+    actions = [{'const_name': constant_name(a[0]), 'method': a[1]} for a in schema['actions']]
+
+    context = {'tables': tables, 'structs': structs, 'actions': actions}
+    for name in ('dispatch.hpp', 'dispatch.cpp'):
+        with open(os.path.join('./gen', name), 'w') as f:
+            f.write(env.get_template(name).render(context))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,81 @@
+#ifndef NEOVIM_CPP__BATCH_HPP
+#define NEOVIM_CPP__BATCH_HPP
+
+#include "msgpack.hpp"
+#include "decode.hpp"
+#include "future.hpp"
+#include "method.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace nvim {
+
+class NvimRPC;
+
+/// Position of one recorded call in a batch, typed by its return value.
+template<typename T>
+struct BatchItem {
+    BatchItem(size_t index, Decoder<T> decode) : index(index), decode(decode) {}
+    size_t index;
+    Decoder<T> decode;
+};
+
+template<>
+struct BatchItem<void> {
+    explicit BatchItem(size_t index) : index(index) {}
+    size_t index;
+};
+
+/// Result of nvim_call_atomic. The response is copied out of the received
+/// message once, get() decodes single entries from that copy.
+struct BatchResult {
+    std::shared_ptr<msgpack::zone> zone;  // owns results and error
+    msgpack::object results;  // array, one entry per call that ran
+    msgpack::object error;    // nil, or [index, type, message] of the call that failed
+
+    bool ok() const { return error.is_nil(); }
+    size_t size() const {
+        return results.type == msgpack::type::ARRAY ? results.via.array.size : 0;
+    }
+
+    template<typename T>
+    T get(const BatchItem<T> &item) const;
+};
+
+namespace detail {
+    void decode_batch_result(const msgpack::object &obj, BatchResult &res);
+} // namespace detail
+
+/// Calls recorded for a single nvim_call_atomic request.
+/// The arguments are packed as the calls are recorded, sending only
+/// prepends the request header. The typed recorders are generated in
+/// Nvim::Batch (see templates/nvim.hpp).
+class BatchBase {
+public:
+    explicit BatchBase(NvimRPC *rpc);
+
+    size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+
+    /// Fire and forget; a failing call is logged.
+    void send();
+    Future<BatchResult> future_send();
+    BatchResult execute();
+
+protected:
+    /// Record one call, returns its index in the batch.
+    template<typename...U>
+    size_t add(const Method &method, const U&...u);
+
+private:
+    void reset();
+
+    NvimRPC *rpc_;
+    msgpack::sbuffer body_;  // packed [method, [args...]] entries
+    uint32_t count_ = 0;
+};
+
+} //namespace nvim
+
+#endif //NEOVIM_CPP__BATCH_HPP
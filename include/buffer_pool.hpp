@@ -0,0 +1,54 @@
+#ifndef NEOVIM_CPP__BUFFER_POOL_HPP
+#define NEOVIM_CPP__BUFFER_POOL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <msgpack.hpp>
+
+namespace nvim {
+
+/// Warmed-up msgpack::sbuffers for outgoing messages, so that packing a
+/// request does not cost a malloc/free pair. Written buffers come back from
+/// the I/O thread (see IoThread::take_recycled) and are handed out again.
+/// Application thread only.
+class BufferPool {
+public:
+    struct Stats {
+        uint64_t hits = 0;    // acquire() served from the pool
+        uint64_t misses = 0;  // acquire() had to allocate
+
+        double hit_rate() const {
+            uint64_t total = hits + misses;
+            return total ? double(hits) / double(total) : 0;
+        }
+    };
+
+    msgpack::sbuffer acquire();
+    /// Keep sbuf for reuse. Oversized buffers (a large batch) and buffers
+    /// beyond kMaxPooled are freed.
+    void release(msgpack::sbuffer &&sbuf);
+    bool full() const { return free_.size() >= kMaxPooled; }
+
+    /// Size of a message packed into an acquired buffer; fresh buffers
+    /// are allocated for the typical size.
+    void note_size(size_t size) {
+        typical_size_ = (typical_size_ * 7 + size) / 8;
+    }
+
+    const Stats &stats() const { return stats_; }
+
+private:
+    static const size_t kMaxPooled = 256;
+    static const size_t kMaxPooledSize = 64 * 1024;
+    static const size_t kMinBufferSize = 256;
+
+    std::vector<msgpack::sbuffer> free_;
+    size_t typical_size_ = kMinBufferSize;
+    Stats stats_;
+};
+
+} //namespace nvim
+
+#endif //NEOVIM_CPP__BUFFER_POOL_HPP
@@ -0,0 +1,61 @@
+#ifndef NEOVIM_CPP__CAPTURE_HPP
+#define NEOVIM_CPP__CAPTURE_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <boost/asio/buffer.hpp>
+#include <msgpack.hpp>
+
+namespace nvim {
+
+/// Traffic capture, for replaying a session offline (tree-replay).
+///
+/// The file is a sequence of msgpack arrays
+/// [direction, microseconds since the capture started, bin], one per chunk
+/// read from or written to the socket. The chunks of one direction put end
+/// to end are the msgpack-rpc stream in that direction, a reader cuts them
+/// into frames with an unpacker.
+enum class Direction : uint8_t {
+    kInbound = 0,   // nvim -> tree
+    kOutbound = 1,  // tree -> nvim
+};
+
+class CaptureWriter {
+public:
+    /// Truncates path, throws boost::system::system_error when it cannot
+    /// be opened.
+    explicit CaptureWriter(const std::string &path);
+    ~CaptureWriter();
+
+    CaptureWriter(const CaptureWriter &) = delete;
+    CaptureWriter &operator=(const CaptureWriter &) = delete;
+
+    void write(Direction dir, const char *data, size_t size);
+    /// The first size bytes of bufs, what a gather write got through.
+    void write(Direction dir, const std::vector<boost::asio::const_buffer> &bufs, size_t size);
+
+private:
+    void write_head(Direction dir, size_t size);
+
+    std::FILE *file_;
+    std::chrono::steady_clock::time_point start_;
+    msgpack::sbuffer head_;
+};
+
+struct CaptureRecord {
+    Direction dir;
+    uint64_t time_us;
+    std::string data;
+};
+
+/// All records of a capture, a truncated last record is dropped. Throws
+/// boost::system::system_error when path cannot be read.
+std::vector<CaptureRecord> read_capture(const std::string &path);
+
+} //namespace nvim
+
+#endif //NEOVIM_CPP__CAPTURE_HPP
@@ -0,0 +1,93 @@
+#ifndef NEOVIM_CPP__DECODE_HPP
+#define NEOVIM_CPP__DECODE_HPP
+
+#include "msgpack.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace nvim {
+
+/// Reads a response straight out of the received msgpack::object into T.
+/// gen_api.py emits one per API return type (see templates/nvim.cpp) from
+/// the helpers below. A value of the wrong type throws msgpack::type_error.
+template<typename T>
+using Decoder = void (*)(const msgpack::object &obj, T &res);
+
+namespace detail {
+    /// Handles (Buffer, Window, Tabpage) are EXT objects whose payload is
+    /// the handle packed as a msgpack integer.
+    inline int64_t decode_ext_integer(const char *p, uint32_t size) {
+        if (size == 0)
+            throw msgpack::type_error();
+        const unsigned char *u = reinterpret_cast<const unsigned char *>(p);
+        if (u[0] < 0x80)    // positive fixint
+            return u[0];
+        if (u[0] >= 0xe0)   // negative fixint
+            return static_cast<int8_t>(u[0]);
+
+        uint32_t len;
+        bool is_signed = u[0] >= 0xd0;
+        switch (u[0]) {
+        case 0xcc: case 0xd0: len = 1; break;
+        case 0xcd: case 0xd1: len = 2; break;
+        case 0xce: case 0xd2: len = 4; break;
+        case 0xcf: case 0xd3: len = 8; break;
+        default: throw msgpack::type_error();
+        }
+        if (size < 1 + len)
+            throw msgpack::type_error();
+
+        uint64_t v = 0;
+        for (uint32_t i = 1; i <= len; ++i)
+            v = (v << 8) | u[i];
+        if (is_signed && len < 8 && (v >> (len * 8 - 1)))
+            v |= ~uint64_t(0) << (len * 8);  // sign extend
+        return static_cast<int64_t>(v);
+    }
+
+    inline void decode_integer(const msgpack::object &obj, int64_t &res) {
+        switch (obj.type) {
+        case msgpack::type::POSITIVE_INTEGER: res = obj.via.u64; break;
+        case msgpack::type::NEGATIVE_INTEGER: res = obj.via.i64; break;
+        default: throw msgpack::type_error();
+        }
+    }
+
+    inline void decode_handle(const msgpack::object &obj, int8_t ext_type, int64_t &res) {
+        if (obj.type != msgpack::type::EXT) {
+            decode_integer(obj, res);
+            return;
+        }
+        if (obj.via.ext.type() != ext_type)
+            throw msgpack::type_error();
+        res = decode_ext_integer(obj.via.ext.data(), obj.via.ext.size);
+    }
+
+    inline void decode_bool(const msgpack::object &obj, bool &res) {
+        if (obj.type != msgpack::type::BOOLEAN)
+            throw msgpack::type_error();
+        res = obj.via.boolean;
+    }
+
+    inline void decode_string(const msgpack::object &obj, std::string &res) {
+        switch (obj.type) {
+        case msgpack::type::STR: res.assign(obj.via.str.ptr, obj.via.str.size); break;
+        case msgpack::type::BIN: res.assign(obj.via.bin.ptr, obj.via.bin.size); break;
+        default: throw msgpack::type_error();
+        }
+    }
+
+    template<typename T>
+    void decode_array(const msgpack::object &obj, std::vector<T> &res, Decoder<T> decode) {
+        if (obj.type != msgpack::type::ARRAY)
+            throw msgpack::type_error();
+        res.resize(obj.via.array.size);
+        for (uint32_t i = 0; i < obj.via.array.size; ++i)
+            decode(obj.via.array.ptr[i], res[i]);
+    }
+} // namespace detail
+
+} //namespace nvim
+
+#endif //NEOVIM_CPP__DECODE_HPP
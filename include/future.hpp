@@ -0,0 +1,154 @@
+#ifndef NEOVIM_CPP__FUTURE_HPP
+#define NEOVIM_CPP__FUTURE_HPP
+
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+
+#include "log.hpp"
+
+// co_await support needs a C++20 build (cmake -DUSE_CXX20=ON).
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#include <coroutine>
+#define NVIM_HAS_COROUTINE 1
+#endif
+#endif
+
+namespace nvim {
+
+class NvimRPC;
+
+namespace detail {
+    struct SlotBase {
+        bool done = false;
+        bool failed = false;  // nvim answered with an error
+        // Continuation installed by then() or co_await, run once the
+        // response is in. It runs from inside the event loop.
+        std::function<void()> on_ready;
+
+        void set_done() {
+            done = true;
+            if (on_ready) {
+                auto cont = std::move(on_ready);
+                on_ready = nullptr;
+                cont();
+            }
+        }
+    };
+
+    template<typename T>
+    struct Slot : SlotBase {
+        T value{};
+    };
+
+    template<>
+    struct Slot<void> : SlotBase {
+    };
+} // namespace detail
+
+/// Typed result of a request that is already on the wire.
+/// get() blocks until the response has been read; other requests can be
+/// sent (and other futures created) in the meantime.
+/// then() and co_await do not block: the rest of the handler runs when the
+/// event loop reads the response, and the loop keeps serving other messages
+/// until then. Use either get() or a continuation, not both.
+template<typename T>
+class Future {
+public:
+    Future(NvimRPC *rpc, uint64_t msgid, std::shared_ptr<detail::Slot<T>> slot) :
+        rpc_(rpc), msgid_(msgid), slot_(std::move(slot)) {
+    }
+
+    bool ready() const;
+    /// Once ready: the request failed, get() then returns T{}.
+    bool failed() const { return slot_->failed; }
+    T get();
+
+    template<typename F>
+    void then(F f) {
+        auto slot = slot_;
+        if (slot->done) {
+            f(std::move(slot->value));
+            return;
+        }
+        slot->on_ready = [slot, f]() mutable { f(std::move(slot->value)); };
+    }
+
+#ifdef NVIM_HAS_COROUTINE
+    bool await_ready() const { return slot_->done; }
+    void await_suspend(std::coroutine_handle<> h) {
+        slot_->on_ready = [h]() { h.resume(); };
+    }
+    T await_resume() { return std::move(slot_->value); }
+#endif
+
+private:
+    NvimRPC *rpc_;
+    uint64_t msgid_;
+    std::shared_ptr<detail::Slot<T>> slot_;
+};
+
+template<>
+class Future<void> {
+public:
+    Future(NvimRPC *rpc, uint64_t msgid, std::shared_ptr<detail::Slot<void>> slot) :
+        rpc_(rpc), msgid_(msgid), slot_(std::move(slot)) {
+    }
+
+    inline bool ready() const;
+    bool failed() const { return slot_->failed; }
+    inline void get();
+
+    template<typename F>
+    void then(F f) {
+        if (slot_->done) {
+            f();
+            return;
+        }
+        slot_->on_ready = f;
+    }
+
+#ifdef NVIM_HAS_COROUTINE
+    bool await_ready() const { return slot_->done; }
+    void await_suspend(std::coroutine_handle<> h) {
+        slot_->on_ready = [h]() { h.resume(); };
+    }
+    void await_resume() {}
+#endif
+
+private:
+    NvimRPC *rpc_;
+    uint64_t msgid_;
+    std::shared_ptr<detail::Slot<void>> slot_;
+};
+
+#ifdef NVIM_HAS_COROUTINE
+/// Fire-and-forget coroutine for request/notification handlers:
+///
+///     nvim::Task Tree::view(...) {
+///         Object rv = co_await api->future_execute_lua(...);
+///     }
+///
+/// The frame starts eagerly and is destroyed when the body returns.
+struct Task {
+    struct promise_type {
+        Task get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() {
+            try {
+                throw;
+            } catch (std::exception &e) {
+                LOG_ERROR("nvim::Task: %s", e.what());
+            }
+        }
+    };
+};
+#endif
+
+} //namespace nvim
+
+#endif //NEOVIM_CPP__FUTURE_HPP
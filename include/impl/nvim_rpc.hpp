@@ -19,100 +19,152 @@ namespace detail {
           return pk;
     }
 
+    template<class T>
+    void fill(Slot<T> &slot, const msgpack::object &obj, Decoder<T> decode) {
+        decode(obj, slot.value);
+        slot.set_done();
+    }
+
 } // namespace detail
 
-template<typename T, typename...U>
-void NvimRPC::call(const std::string &method, T& res, const U&...u) {
-    Object v = do_call(method, u...);
-    // std::cout << "T NvimRPC::call" << std::endl;
+template<typename T>
+bool Future<T>::ready() const {
+    return slot_->done;
+}
 
-    res = boost::get<T>(v);
+template<typename T>
+T Future<T>::get() {
+    rpc_->wait(msgid_);
+    return std::move(slot_->value);
 }
 
-template<typename...U>
-void NvimRPC::call(const std::string &method, Integer& res, const U& ...u) {
-    Object v = do_call(method, u...);
-    // std::cout << "Integer NvimRPC::call" << std::endl;
-
-    // int64_t is only for negative integer.
-    if(v.is_int64_t())       res = v.as_int64_t();
-    else if(v.is_uint64_t()) res = v.as_uint64_t();
-    else if (v.is_ext()) {
-        // NOTE: Buffer: 0; Tabpage: 2; Window: 1
-        std::cout << type_name(v) << std::endl;
-        std::cout << int(v.as_ext().type()) << std::endl;
-        std::cout << v.as_ext().size() << std::endl;
-        res = int(v.as_ext().data()[0]);
-    }
-    else std::cout << "invalid response type" << std::endl; //TODO: add error handler
+inline bool Future<void>::ready() const {
+    return slot_->done;
 }
 
-template<typename...U>
-void NvimRPC::call(const std::string &method, Object& res, const U& ...u) {
-    Object v = do_call(method, u...);
-    // std::cout << "Object NvimRPC::call" << std::endl;
-    res = v;
+inline void Future<void>::get() {
+    rpc_->wait(msgid_);
+}
+
+template<typename T, typename...U>
+void NvimRPC::call(const Method &method, T &res, Decoder<T> decode, const U&...u) {
+    uint64_t msgid = send_request(method,
+        [&res, &method, decode](const msgpack::object &err, const msgpack::object &obj) {
+            // [type=1, msgid(uint), error(str?), result(...)]
+            if (!err.is_nil())
+                LOG_WARN("%s: %s", method.name, dump(err).c_str());
+            else
+                decode(obj, res);
+        }, u...);
+
+    wait(msgid);
 }
 
 template<typename...U>
-void NvimRPC::call(const std::string &method, std::nullptr_t res, const U&...u) {
-    do_call(method, u...);
-    // std::cout << "void NvimRPC::call" << std::endl;
+void NvimRPC::call(const Method &method, std::nullptr_t, const U&...u) {
+    uint64_t msgid = send_request(method,
+        [&method](const msgpack::object &err, const msgpack::object &) {
+            if (!err.is_nil())
+                LOG_WARN("%s: %s", method.name, dump(err).c_str());
+        }, u...);
+
+    wait(msgid);
 }
 
 template<typename...U>
-Object NvimRPC::do_call(const std::string &method, const U&...u) {
-    msgpack::sbuffer sbuf;
+MethodStats::Entry &NvimRPC::write_request(uint64_t msgid, const Method &method, const U&...u) {
+    msgpack::sbuffer sbuf = acquire_buffer();
     detail::Packer pk(&sbuf);
-    pk.pack_array(4) << (uint64_t)REQUEST
-                     << msgid_++
-                     << method;
+    // [type, msgid, method]: only msgid is packed here, the rest is constant.
+    sbuf.write(detail::kRequestHead, detail::kRequestHeadSize);
+    pk << msgid;
+    sbuf.write(method.packed, method.size);
 
     pk.pack_array(sizeof...(u));
     detail::pack(pk, u...);
 
-    // msgpack::object_handle oh = msgpack::unpack(sbuf.data(), sbuf.size());
-    // msgpack::object deserialized = oh.get();
-    // std::cout << "sbuf = " << deserialized << std::endl;
-
-    socket_.write(sbuf.data(), sbuf.size(), 5);
-
-    msgpack::unpacked result = socket_.read2(5);
-    msgpack::object obj(result.get());
+    MethodStats::Entry &stats = stats_.entry(method.name);
+    stats.add_bytes(sbuf.size());
+    enqueue(std::move(sbuf));
+    return stats;
+}
 
-    //TODO: full-state response handler should be implemented
+template<typename...U>
+uint64_t NvimRPC::send_request(const Method &method, ResponseHandler handler, const U&...u) {
+    uint64_t msgid = msgid_++;
+    // Writing may wait for room in the outgoing queue, that is latency too.
+    auto sent = MethodStats::Clock::now();
+    MethodStats::Entry &stats = write_request(msgid, method, u...);
+    add_pending(msgid, std::move(handler), stats, sent);
+    return msgid;
+}
 
-    // std::cout << "res = " << obj << std::endl;
-    msgpack::type::tuple<int64_t, int64_t, Object, Object> dst;
-    // [type=1, msgid(uint), error(str?), result(...)]
-    obj.convert(dst);
-    return dst.get<3>();
+template<typename T>
+T BatchResult::get(const BatchItem<T> &item) const {
+    if (item.index >= size())
+        throw std::out_of_range("BatchResult::get");
+    T res{};
+    item.decode(results.via.array.ptr[item.index], res);
+    return res;
 }
 
 template<typename...U>
-void NvimRPC::async_call(const std::string &method, const U&...u) {
-    msgpack::sbuffer sbuf;
-    detail::Packer pk(&sbuf);
-    pk.pack_array(4) << (uint64_t)REQUEST
-                     << msgid_++
-                     << method;
-
+size_t BatchBase::add(const Method &method, const U&...u) {
+    detail::Packer pk(&body_);
+    body_.write(detail::kAtomicCallHead, detail::kAtomicCallHeadSize);
+    body_.write(method.packed, method.size);
     pk.pack_array(sizeof...(u));
     detail::pack(pk, u...);
+    return count_++;
+}
 
-    socket_.write(sbuf.data(), sbuf.size(), 5);
+template<typename T, typename...U>
+Future<T> NvimRPC::future_call(const Method &method, Decoder<T> decode, const U&...u) {
+    auto slot = std::make_shared<detail::Slot<T>>();
+    uint64_t msgid = send_request(method,
+        [slot, method, decode](const msgpack::object &err, const msgpack::object &res) {
+            if (!err.is_nil()) {
+                LOG_WARN("%s: %s", method.name, dump(err).c_str());
+                slot->failed = true;
+                slot->set_done();
+                return;
+            }
+            detail::fill(*slot, res, decode);
+        }, u...);
+
+    return Future<T>(this, msgid, slot);
+}
+
+template<typename...U>
+Future<void> NvimRPC::future_call(const Method &method, std::nullptr_t, const U&...u) {
+    auto slot = std::make_shared<detail::Slot<void>>();
+    uint64_t msgid = send_request(method,
+        [slot, method](const msgpack::object &err, const msgpack::object &) {
+            if (!err.is_nil()) {
+                LOG_WARN("%s: %s", method.name, dump(err).c_str());
+                slot->failed = true;
+            }
+            slot->set_done();
+        }, u...);
+
+    return Future<void>(this, msgid, slot);
+}
+
+template<typename...U>
+void NvimRPC::async_call(const Method &method, const U&...u) {
+    write_request(msgid_++, method, u...);
 }
 
 bool NvimRPC::send_response(uint64_t msgid, const Object &err, const Object &res)
 {
-    msgpack::sbuffer sbuf;
+    msgpack::sbuffer sbuf = acquire_buffer();
     detail::Packer pk(&sbuf);
     pk.pack_array(4) << (uint64_t)RESPONSE
                      << msgid
                      << err
                      << res;
 
-    socket_.write(sbuf.data(), sbuf.size(), 5);
+    enqueue(std::move(sbuf));
 
     return true;
 }
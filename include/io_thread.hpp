@@ -0,0 +1,144 @@
+#ifndef NEOVIM_CPP__IO_THREAD_HPP
+#define NEOVIM_CPP__IO_THREAD_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <msgpack.hpp>
+#include "reactor.hpp"
+#include "socket.hpp"
+#include "spsc_ring.hpp"
+
+namespace nvim {
+
+class IoThread;
+
+/// Ends a receive() wait of an IoThread from any thread. Held by threads
+/// that may outlive the connection, once the IoThread is gone wake() does
+/// nothing.
+class Waker {
+public:
+    void wake();
+
+private:
+    friend class IoThread;
+    std::mutex mutex_;
+    IoThread *io_ = nullptr;
+};
+
+/// Runs all reads and writes of a connected Socket on a thread of its own.
+/// The application thread exchanges framed messages with it through two
+/// SpscRings, so the socket keeps being served while the application is
+/// busy (scanning a large directory, say) and outgoing messages start
+/// streaming out while later ones are still being produced.
+///
+/// On Linux the thread sleeps in a Reactor (epoll), elsewhere it runs the
+/// socket's io_service.
+class IoThread {
+public:
+    explicit IoThread(Socket &socket);
+    ~IoThread();
+
+    /// Take over the socket. Nothing else may use it afterwards.
+    void start();
+    void stop();
+
+    /// Application thread: queue one message for writing. Blocks while
+    /// more than kHighWater bytes are waiting to be written, until the
+    /// I/O thread is back under kLowWater.
+    void send(msgpack::sbuffer &&sbuf);
+    size_t queued_bytes() const { return queued_bytes_.load(); }
+    /// Application thread: next message read from the socket.
+    /// Returns false on timeout, throws once the connection is gone (eof
+    /// when nvim closed it). An interruptible receive() also returns false
+    /// once a Waker has been woken.
+    bool receive(msgpack::unpacked &msg, double timeout_sec, bool interruptible = false);
+    /// Application thread: next message if one has been read already.
+    /// Never blocks, a closed connection surfaces from receive().
+    bool try_receive(msgpack::unpacked &msg);
+    /// Application thread: a buffer that has been written, for reuse.
+    bool take_recycled(msgpack::sbuffer &sbuf) { return recycled_.pop(sbuf); }
+    /// For threads of the application that have news for it.
+    std::shared_ptr<Waker> waker() const { return waker_; }
+
+private:
+    // I/O thread only
+    void run();
+    void on_wakeup();
+    void on_message(msgpack::unpacked &&msg);
+    void on_error(const boost::system::error_code &ec);
+    void drain_backlog();
+    void write_some();
+    void recycle_written();
+
+    void written(size_t bytes);
+
+    // Application thread
+    void schedule_write();
+    void request_drain();
+    void wait_for_room();
+
+    void wake();
+    void notify();
+    void notify_room();
+    // Any thread, through Waker.
+    void interrupt();
+    friend class Waker;
+
+    static const size_t kRingSize = 1024;
+    // Bound of the outgoing queue, in bytes not yet written.
+    static const size_t kHighWater = 4 * 1024 * 1024;
+    static const size_t kLowWater = 1024 * 1024;
+    // A write that makes no progress for this long fails the connection.
+    static constexpr double kWriteTimeout = 5;
+
+    Socket &socket_;
+    std::thread thread_;
+#ifdef NVIM_HAS_EPOLL
+    Reactor reactor_;
+    std::atomic<bool> stopping_{false};
+    // Position of the next byte to write in writing_.
+    size_t write_index_ = 0;
+    size_t write_offset_ = 0;
+    bool write_timer_armed_ = false;
+#else
+    std::unique_ptr<boost::asio::io_service::work> work_;
+#endif
+
+    SpscRing<msgpack::sbuffer> out_;   // application -> I/O thread
+    SpscRing<msgpack::unpacked> in_;   // I/O thread -> application
+    SpscRing<msgpack::sbuffer> recycled_;  // written buffers going back
+
+    // Set from send() until the I/O thread finds out_ empty, so that only
+    // the first message after an idle period wakes it.
+    std::atomic<bool> write_scheduled_{false};
+    std::atomic<size_t> queued_bytes_{0};
+    std::vector<msgpack::sbuffer> writing_;   // buffers of the write in progress
+    // Messages read while in_ was full; reading never stops for a slow consumer.
+    std::deque<msgpack::unpacked> backlog_;
+    std::atomic<bool> backlogged_{false};
+    std::atomic<bool> drain_requested_{false};
+
+    // Only used to put the application thread to sleep, the messages
+    // themselves go through the rings.
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    std::atomic<bool> waiting_{false};
+    std::atomic<bool> interrupted_{false};
+    std::shared_ptr<Waker> waker_;
+    // send() waiting for the I/O thread to catch up.
+    std::condition_variable room_;
+    std::atomic<bool> send_waiting_{false};
+
+    boost::system::error_code error_;  // written before closed_ is set
+    std::atomic<bool> closed_{false};
+};
+
+} //namespace nvim
+
+#endif //NEOVIM_CPP__IO_THREAD_HPP
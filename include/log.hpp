@@ -0,0 +1,99 @@
+#ifndef NEOVIM_CPP__LOG_HPP
+#define NEOVIM_CPP__LOG_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+
+#include <boost/utility/string_ref.hpp>
+
+// Levels below TREE_LOG_LEVEL are compiled out, their arguments are not
+// even evaluated: 0 debug, 1 info, 2 warn, 3 error, 4 nothing.
+#ifndef TREE_LOG_LEVEL
+#ifdef NDEBUG
+#define TREE_LOG_LEVEL 1
+#else
+#define TREE_LOG_LEVEL 0
+#endif
+#endif
+
+#ifdef __GNUC__
+#define TREE_LOG_PRINTF(fmt, args) __attribute__((format(printf, fmt, args)))
+#else
+#define TREE_LOG_PRINTF(fmt, args)
+#endif
+
+namespace nvim {
+
+enum class LogLevel : int { kDebug, kInfo, kWarn, kError, kOff };
+
+/// printf-style logging off the calling thread. A record is formatted into
+/// a fixed-size slot of the calling thread's own ring (SpscRing), a writer
+/// thread drains the rings into the log file. Nothing is allocated or
+/// written on the caller's side, and when a ring is full the record is
+/// dropped and counted rather than waited for.
+class Logger {
+public:
+    static const size_t kMessageSize = 240;  // longer messages are cut
+    static const size_t kRingSize = 512;     // records per thread
+
+    struct Record {
+        std::chrono::system_clock::time_point time;
+        LogLevel level;
+        const char *file;
+        int line;
+        char msg[kMessageSize];
+    };
+
+    /// Append records to path from now on, stderr until then.
+    static void open(const char *path);
+
+    static bool enabled(LogLevel level) {
+        return static_cast<int>(level) >= level_.load(std::memory_order_relaxed);
+    }
+    static LogLevel level() { return static_cast<LogLevel>(level_.load(std::memory_order_relaxed)); }
+    /// At runtime, levels compiled out by TREE_LOG_LEVEL stay out.
+    static void set_level(LogLevel level) { level_.store(static_cast<int>(level), std::memory_order_relaxed); }
+    /// "debug", "info", "warn", "error" or "off", false for anything else.
+    static bool parse_level(boost::string_ref name, LogLevel &level);
+
+    static void write(LogLevel level, const char *file, int line, const char *fmt, ...)
+        TREE_LOG_PRINTF(4, 5);
+
+    /// Wait until everything logged so far is written.
+    static void flush();
+
+private:
+    static std::atomic<int> level_;
+};
+
+} //namespace nvim
+
+#define TREE_LOG(level, ...) \
+do { \
+    if (nvim::Logger::enabled(level)) \
+        nvim::Logger::write(level, __FILE__, __LINE__, __VA_ARGS__); \
+} while (0)
+
+#if TREE_LOG_LEVEL <= 0
+#define LOG_DEBUG(...) TREE_LOG(nvim::LogLevel::kDebug, __VA_ARGS__)
+#else
+#define LOG_DEBUG(...) do {} while (0)
+#endif
+#if TREE_LOG_LEVEL <= 1
+#define LOG_INFO(...) TREE_LOG(nvim::LogLevel::kInfo, __VA_ARGS__)
+#else
+#define LOG_INFO(...) do {} while (0)
+#endif
+#if TREE_LOG_LEVEL <= 2
+#define LOG_WARN(...) TREE_LOG(nvim::LogLevel::kWarn, __VA_ARGS__)
+#else
+#define LOG_WARN(...) do {} while (0)
+#endif
+#if TREE_LOG_LEVEL <= 3
+#define LOG_ERROR(...) TREE_LOG(nvim::LogLevel::kError, __VA_ARGS__)
+#else
+#define LOG_ERROR(...) do {} while (0)
+#endif
+
+#endif //NEOVIM_CPP__LOG_HPP
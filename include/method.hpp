@@ -0,0 +1,28 @@
+#ifndef NEOVIM_CPP__METHOD_HPP
+#define NEOVIM_CPP__METHOD_HPP
+
+#include <cstdint>
+
+namespace nvim {
+
+/// An API method name together with its msgpack str encoding.
+/// The generated wrappers define one constexpr Method per function (see
+/// gen_api.py), so a request only packs its msgid and arguments at runtime.
+struct Method {
+    const char *name;
+    const char *packed;  // msgpack str header followed by the name
+    uint32_t size;       // bytes in packed
+};
+
+namespace detail {
+    // fixarray(4), REQUEST: the constant head of [type, msgid, method, args]
+    constexpr char kRequestHead[] = "\x94\x00";
+    constexpr uint32_t kRequestHeadSize = 2;
+    // fixarray(2): head of a [method, args] entry of nvim_call_atomic
+    constexpr char kAtomicCallHead[] = "\x92";
+    constexpr uint32_t kAtomicCallHeadSize = 1;
+} // namespace detail
+
+} //namespace nvim
+
+#endif //NEOVIM_CPP__METHOD_HPP
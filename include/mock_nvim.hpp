@@ -0,0 +1,170 @@
+#ifndef NEOVIM_CPP__MOCK_NVIM_HPP
+#define NEOVIM_CPP__MOCK_NVIM_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/system/system_error.hpp>
+#include <msgpack.hpp>
+
+#include "object_ref.hpp"
+#include "rpc_stats.hpp"
+
+namespace nvim {
+
+/// Stand-in for nvim on the other end of the server's connection, for
+/// benchmarks on a machine without nvim (see tree-bench).
+///
+/// It implements the part of the API the server uses and keeps a real
+/// model of what those calls do to nvim: buffer lines, highlights per
+/// namespace, the cursor. Lua and Vim script are not run, execute_lua,
+/// command and call_function are only counted. Everything the server sent
+/// is accounted for in State::work and State::methods.
+class MockNvim {
+public:
+    struct Highlight {
+        int64_t ns_id;
+        std::string group;
+        int64_t line;
+        int64_t col_start;
+        int64_t col_end;   // -1: to the end of the line
+    };
+
+    struct Buffer {
+        std::string name;
+        std::vector<std::string> lines{""};
+        std::vector<Highlight> highlights;
+    };
+
+    struct Work {
+        uint64_t requests = 0;        // from the server, atomic calls counted once
+        uint64_t calls = 0;           // API calls, each call of a batch included
+        uint64_t bytes = 0;           // received from the server
+        uint64_t lines_set = 0;       // lines written by buf_set_lines
+        uint64_t lines_deleted = 0;
+        uint64_t highlights_added = 0;
+        uint64_t highlights_cleared = 0;
+        uint64_t commands = 0;        // command, execute_lua, call_function
+    };
+
+    struct State {
+        std::map<int64_t, Buffer> buffers;
+        int64_t current_buffer = 1;
+        int64_t last_created = 0;     // 0 until create_buf
+        std::map<std::string, int64_t> namespaces;
+        int64_t cursor_row = 1;       // 1-based like nvim_win_set_cursor
+        int64_t cursor_col = 0;
+        Work work;
+        MethodStats methods;          // calls and bytes per API method
+    };
+
+    /// Listen on the local socket path, the server connects to it as to
+    /// nvim's servername.
+    explicit MockNvim(const std::string &path);
+    ~MockNvim();
+
+    MockNvim(const MockNvim &) = delete;
+    MockNvim &operator=(const MockNvim &) = delete;
+
+    /// Wait for the server to connect, then answer it on a thread of our own.
+    void accept();
+
+    /// Send a request to the server and wait for the response, the whole
+    /// [1, msgid, error, result] message. Throws boost::system::system_error
+    /// (timed_out) when it does not come.
+    template<typename...U>
+    msgpack::unpacked request(const std::string &method, const U&...args);
+    template<typename...U>
+    void notify(const std::string &method, const U&...args);
+
+    /// Copy of the model.
+    State state() const;
+    /// Wait until pred holds for the model, false on timeout.
+    bool wait(const std::function<bool(const State &)> &pred, double timeout_sec);
+
+    /// Hang up, the server sees eof.
+    void close();
+
+private:
+    using Packer = msgpack::packer<msgpack::sbuffer>;
+
+    void serve();
+    void handle_request(const msgpack::object &msg, size_t bytes);
+    // Runs one API call on the model and packs its result into out.
+    // Returns false with err set when nvim would fail it.
+    bool call(boost::string_ref method, const ObjectRef &args, msgpack::sbuffer &out, std::string &err);
+    void call_atomic(const ObjectRef &calls, msgpack::sbuffer &out);
+    Buffer &buffer(const ObjectRef &handle);
+    void write(const msgpack::sbuffer &sbuf);
+
+    boost::asio::io_service io_service_;
+    boost::asio::local::stream_protocol::acceptor acceptor_;
+    boost::asio::local::stream_protocol::socket socket_;
+    std::string path_;
+    std::thread thread_;
+
+    mutable std::mutex mutex_;       // state_, responses_, closed_
+    std::condition_variable changed_;
+    State state_;
+    std::map<uint64_t, msgpack::unpacked> responses_;
+    bool closed_ = false;
+    uint64_t msgid_ = 0;
+    int64_t next_ns_ = 1;
+
+    std::mutex write_mutex_;
+};
+
+template<typename...U>
+msgpack::unpacked MockNvim::request(const std::string &method, const U&...args)
+{
+    msgpack::sbuffer sbuf;
+    Packer pk(&sbuf);
+    uint64_t msgid;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        msgid = msgid_++;
+    }
+    pk.pack_array(4);
+    pk.pack_uint8(0);
+    pk.pack_uint64(msgid);
+    pk.pack(method);
+    pk.pack_array(sizeof...(args));
+    (void)std::initializer_list<int>{(pk.pack(args), 0)...};
+    write(sbuf);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    // Generous, the server may be scanning a large directory.
+    if (!changed_.wait_for(lock, std::chrono::seconds(60),
+            [&] { return responses_.count(msgid) || closed_; }) || !responses_.count(msgid))
+        throw boost::system::system_error(boost::asio::error::timed_out);
+    msgpack::unpacked res = std::move(responses_[msgid]);
+    responses_.erase(msgid);
+    return res;
+}
+
+template<typename...U>
+void MockNvim::notify(const std::string &method, const U&...args)
+{
+    msgpack::sbuffer sbuf;
+    Packer pk(&sbuf);
+    pk.pack_array(3);
+    pk.pack_uint8(2);
+    pk.pack(method);
+    pk.pack_array(sizeof...(args));
+    (void)std::initializer_list<int>{(pk.pack(args), 0)...};
+    write(sbuf);
+}
+
+} //namespace nvim
+
+#endif //NEOVIM_CPP__MOCK_NVIM_HPP
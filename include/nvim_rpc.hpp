@@ -4,10 +4,22 @@
 
 #include "msgpack.hpp"
 #include "util.h"
+#include <deque>
+#include <functional>
 #include <string>
 #include <iostream>
 #include <sstream>
-
+#include <stdexcept>
+#include <unordered_map>
+
+#include "batch.hpp"
+#include "buffer_pool.hpp"
+#include "decode.hpp"
+#include "future.hpp"
+#include "io_thread.hpp"
+#include "log.hpp"
+#include "object_ref.hpp"
+#include "rpc_stats.hpp"
 #include "socket.hpp"
 
 namespace nvim {
@@ -31,41 +43,113 @@ class NvimRPC {
     };
 
 public:
+    /// Called with the error and result of a response, both point into the
+    /// zone of the received message and are only valid during the call.
+    using ResponseHandler = std::function<void(const msgpack::object &err,
+                                               const msgpack::object &res)>;
+
     NvimRPC() :
-        msgid_(0) {
+        msgid_(0),
+        io_(socket_) {
     }
 
+    /// Once connected, the socket belongs to the I/O thread.
     void connect_tcp(const std::string &host,
             const std::string &service, double timeout_sec) {
         socket_.connect_tcp(host, service, timeout_sec);
+        io_.start();
     }
 
     void connect_pipe(const std::string &name, double timeout_sec) {
         socket_.connect_pipe(name, timeout_sec);
+        io_.start();
+    }
+
+    void connect_stdio() {
+        socket_.connect_stdio();
+        io_.start();
     }
 
+    void connect_fd(int fd) {
+        socket_.connect_fd(fd);
+        io_.start();
+    }
+
+    /// Blocking call, the result is decoded into res. On an error response
+    /// res is left untouched.
     template<typename T, typename...U>
-    void call(const std::string &method, T& res, const U&...u);
+    void call(const Method &method, T& res, Decoder<T> decode, const U&...u);
 
     template<typename...U>
-    void call(const std::string &method, Integer& res, const U&...u);
+    void call(const Method &method, std::nullptr_t res, const U&...u);
+    inline bool send_response(uint64_t msgid, const Object &err, const Object &res);
 
     template<typename...U>
-    void call(const std::string &method, Object& res, const U&...u);
+    void async_call(const Method &method, const U&...u);
+
+    template<typename T, typename...U>
+    Future<T> future_call(const Method &method, Decoder<T> decode, const U&...u);
 
     template<typename...U>
-    void call(const std::string &method, std::nullptr_t res, const U&...u);
-    inline bool send_response(uint64_t msgid, const Object &err, const Object &res);
+    Future<void> future_call(const Method &method, std::nullptr_t, const U&...u);
 
+    /// Send a request without waiting; handler runs when its response arrives.
     template<typename...U>
-    void async_call(const std::string &method, const U&...u);
+    uint64_t send_request(const Method &method, ResponseHandler handler, const U&...u);
+    /// Send calls packed by a BatchBase as one nvim_call_atomic request.
+    /// Without handler, nobody waits for the response.
+    uint64_t send_atomic(msgpack::sbuffer &&calls, uint32_t count, ResponseHandler handler);
+    /// Block until the response of msgid has been handled.
+    void wait(uint64_t msgid, double timeout_sec = 5);
+    /// Next request or notification from nvim, responses met on the way are
+    /// handed to their pending handlers. Throws timed_out on timeout and
+    /// when a waker() is woken.
+    msgpack::unpacked next_message(double timeout_sec);
+    /// Like next_message() but returns false instead of waiting when
+    /// nothing has been read yet.
+    bool try_next_message(msgpack::unpacked &msg);
+
+    /// Empty buffer for packing an outgoing message, from the pool.
+    msgpack::sbuffer acquire_buffer();
+    const BufferPool::Stats &buffer_stats() const { return pool_.stats(); }
+    /// Outgoing requests per method. Latency is measured until the response
+    /// is handled, so async_call() requests only count calls and bytes.
+    const MethodStats &method_stats() const { return stats_; }
+    /// Every byte handed to the I/O thread so far, responses included.
+    const uint64_t &bytes_sent() const { return bytes_sent_; }
+    size_t queued_bytes() const { return io_.queued_bytes(); }
+    /// Lets another thread end a next_message() wait early, waits for a
+    /// response are not affected.
+    std::shared_ptr<Waker> waker() const { return io_.waker(); }
+
 private:
     template<typename...U>
-    Object do_call(const std::string &method, const U&...u);
+    MethodStats::Entry &write_request(uint64_t msgid, const Method &method, const U&...u);
+    void add_pending(uint64_t msgid, ResponseHandler &&handler,
+                     MethodStats::Entry &stats, MethodStats::Clock::time_point sent);
+    bool handle_response(const msgpack::unpacked &msg);
+    void enqueue(msgpack::sbuffer &&sbuf);
+    msgpack::unpacked receive(double timeout_sec, bool interruptible = false);
 
     uint64_t msgid_;
+    struct Pending {
+        ResponseHandler handler;
+        MethodStats::Entry *stats;
+        MethodStats::Clock::time_point sent;
+    };
+    // Requests in flight, keyed by msgid. Responses to async_call are not
+    // registered here and are dropped when they arrive.
+    std::unordered_map<uint64_t, Pending> pending_;
+    // Requests/notifications read while waiting for a response.
+    std::deque<msgpack::unpacked> inbox_;
+    BufferPool pool_;
+    MethodStats stats_;
+    uint64_t bytes_sent_ = 0;
 public:
     Socket socket_;
+private:
+    // Declared after socket_, which it is constructed with.
+    IoThread io_;
 
 };
 
@@ -74,4 +158,3 @@ public:
 #include "impl/nvim_rpc.hpp"
 
 #endif //NEOVIM_CPP__NVIM_RPC_HPP
-
@@ -0,0 +1,116 @@
+#ifndef NEOVIM_CPP__OBJECT_REF_HPP
+#define NEOVIM_CPP__OBJECT_REF_HPP
+
+#include "msgpack.hpp"
+#include "decode.hpp"
+#include <boost/utility/string_ref.hpp>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+namespace nvim {
+
+/// Read-only view of a msgpack::object of a received message.
+/// Nothing is copied, so a view is only valid as long as the message it
+/// was taken from. Accessors throw msgpack::type_error on a type mismatch,
+/// like msgpack::object::as() does.
+class ObjectRef {
+public:
+    ObjectRef() : obj_(&nil()) {}
+    ObjectRef(const msgpack::object &obj) : obj_(&obj) {}
+
+    msgpack::type::object_type type() const { return obj_->type; }
+    bool is_nil() const { return obj_->type == msgpack::type::NIL; }
+    bool is_array() const { return obj_->type == msgpack::type::ARRAY; }
+    bool is_map() const { return obj_->type == msgpack::type::MAP; }
+    bool is_string() const {
+        return obj_->type == msgpack::type::STR || obj_->type == msgpack::type::BIN;
+    }
+
+    /// Integers and handles (Buffer, Window, Tabpage).
+    int64_t as_int() const {
+        int64_t res;
+        if (obj_->type == msgpack::type::EXT)
+            res = detail::decode_ext_integer(obj_->via.ext.data(), obj_->via.ext.size);
+        else
+            detail::decode_integer(*obj_, res);
+        return res;
+    }
+
+    bool as_bool() const {
+        bool res;
+        detail::decode_bool(*obj_, res);
+        return res;
+    }
+
+    boost::string_ref as_string_ref() const {
+        switch (obj_->type) {
+        case msgpack::type::STR: return boost::string_ref(obj_->via.str.ptr, obj_->via.str.size);
+        case msgpack::type::BIN: return boost::string_ref(obj_->via.bin.ptr, obj_->via.bin.size);
+        default: throw msgpack::type_error();
+        }
+    }
+
+    std::string as_string() const {
+        return as_string_ref().to_string();
+    }
+
+    /// Number of elements of an array or pairs of a map.
+    uint32_t size() const {
+        switch (obj_->type) {
+        case msgpack::type::ARRAY: return obj_->via.array.size;
+        case msgpack::type::MAP: return obj_->via.map.size;
+        default: throw msgpack::type_error();
+        }
+    }
+
+    ObjectRef at(uint32_t i) const {
+        if (obj_->type != msgpack::type::ARRAY)
+            throw msgpack::type_error();
+        if (i >= obj_->via.array.size)
+            throw std::out_of_range("ObjectRef::at");
+        return ObjectRef(obj_->via.array.ptr[i]);
+    }
+
+    /// Value of a map entry with a string key, nil if there is none.
+    ObjectRef get(boost::string_ref key) const {
+        if (obj_->type != msgpack::type::MAP)
+            throw msgpack::type_error();
+        for (uint32_t i = 0; i < obj_->via.map.size; ++i) {
+            const msgpack::object_kv &kv = obj_->via.map.ptr[i];
+            if (ObjectRef(kv.key).is_string() && ObjectRef(kv.key).as_string_ref() == key)
+                return ObjectRef(kv.val);
+        }
+        return ObjectRef();
+    }
+
+    /// Call f(key, value) for each pair of a map.
+    template<typename F>
+    void for_each_pair(F f) const {
+        if (obj_->type != msgpack::type::MAP)
+            throw msgpack::type_error();
+        for (uint32_t i = 0; i < obj_->via.map.size; ++i)
+            f(ObjectRef(obj_->via.map.ptr[i].key), ObjectRef(obj_->via.map.ptr[i].val));
+    }
+
+    /// Copy into an owning type, e.g. Object or Dictionary, for values
+    /// that outlive the message.
+    template<typename T>
+    T &convert(T &v) const {
+        return obj_->convert(v);
+    }
+
+    const msgpack::object &object() const { return *obj_; }
+
+private:
+    static const msgpack::object &nil() {
+        static const msgpack::object obj;
+        return obj;
+    }
+
+    const msgpack::object *obj_;
+};
+
+} //namespace nvim
+
+#endif //NEOVIM_CPP__OBJECT_REF_HPP
@@ -0,0 +1,60 @@
+#ifndef NEOVIM_CPP__REACTOR_HPP
+#define NEOVIM_CPP__REACTOR_HPP
+
+// epoll, eventfd and timerfd are Linux only, elsewhere IoThread runs the
+// socket on its boost::asio io_service instead.
+#if defined(__linux__)
+#define NVIM_HAS_EPOLL 1
+#endif
+
+#ifdef NVIM_HAS_EPOLL
+
+namespace nvim {
+
+/// Readiness loop of IoThread: the connection watched edge-triggered, an
+/// eventfd to wake the loop from other threads and a timerfd for the
+/// deadline of the operation in progress. wait() sleeps in epoll_wait()
+/// until one of them fires, an idle connection costs no CPU.
+class Reactor {
+public:
+    enum {
+        kReadable = 1 << 0,
+        kWritable = 1 << 1,
+        kWakeup   = 1 << 2,
+        kTimeout  = 1 << 3,
+    };
+
+    Reactor();
+    ~Reactor();
+
+    Reactor(const Reactor &) = delete;
+    Reactor &operator=(const Reactor &) = delete;
+
+    /// Events are reported once per transition, the caller reads/writes
+    /// until the socket would block. rfd and wfd differ for stdio.
+    void watch(int rfd, int wfd);
+    void unwatch();
+
+    /// Any thread.
+    void wakeup();
+
+    /// One-shot deadline, re-arming replaces the previous one.
+    void arm_timer(double timeout_sec);
+    void disarm_timer();
+
+    /// Block until something happens, returns the events that did.
+    unsigned wait();
+
+private:
+    int epfd_;
+    int eventfd_;
+    int timerfd_;
+    int rfd_ = -1;
+    int wfd_ = -1;
+};
+
+} //namespace nvim
+
+#endif // NVIM_HAS_EPOLL
+
+#endif //NEOVIM_CPP__REACTOR_HPP
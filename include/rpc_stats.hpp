@@ -0,0 +1,79 @@
+#ifndef NEOVIM_CPP__RPC_STATS_HPP
+#define NEOVIM_CPP__RPC_STATS_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+
+#include <boost/utility/string_ref.hpp>
+
+namespace nvim {
+
+/// Count, bytes and latency per method name. Latencies go into fixed
+/// power-of-two buckets of microseconds, so recording is a few additions
+/// and the table never grows past one entry per method.
+class MethodStats {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // Bucket i counts latencies below 2^i us, the last one everything above.
+    static const size_t kBuckets = 24;
+
+    struct Entry {
+        uint64_t count = 0;
+        uint64_t bytes = 0;
+        uint64_t timed = 0;      // calls with a latency, count includes the others
+        uint64_t total_us = 0;
+        uint64_t max_us = 0;
+        uint64_t buckets[kBuckets] = {};
+
+        void add_bytes(size_t n) { ++count; bytes += n; }
+        void add_latency(Clock::duration elapsed);
+        /// Upper bound of the bucket holding the p-th percentile, 0 < p <= 1.
+        uint64_t percentile_us(double p) const;
+
+        static uint64_t bucket_bound_us(size_t i) { return uint64_t(1) << i; }
+    };
+
+    /// The entry of name, created on first use. References stay valid.
+    Entry &entry(boost::string_ref name);
+
+    const std::map<std::string, Entry, std::less<>> &entries() const { return entries_; }
+
+private:
+    std::map<std::string, Entry, std::less<>> entries_;
+};
+
+/// Records the time until it goes out of scope as one call of name, with
+/// the bytes counted by *sent meanwhile (what the handler sent to nvim).
+class ScopedStats {
+public:
+    ScopedStats(MethodStats &stats, boost::string_ref name, const uint64_t &sent) :
+        entry_(stats.entry(name)),
+        sent_(sent),
+        sent0_(sent),
+        start_(MethodStats::Clock::now())
+    {
+    }
+
+    ~ScopedStats() {
+        entry_.add_bytes(sent_ - sent0_);
+        entry_.add_latency(MethodStats::Clock::now() - start_);
+    }
+
+    ScopedStats(const ScopedStats &) = delete;
+    ScopedStats &operator=(const ScopedStats &) = delete;
+
+private:
+    MethodStats::Entry &entry_;
+    const uint64_t &sent_;
+    uint64_t sent0_;
+    MethodStats::Clock::time_point start_;
+};
+
+} //namespace nvim
+
+#endif //NEOVIM_CPP__RPC_STATS_HPP
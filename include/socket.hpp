@@ -2,46 +2,107 @@
 #define NEOVIM_CPP__SOCKET_HPP
 #define BOOST_VARIANT_USE_RELAXED_GET_BY_DEFAULT
 
-#include <boost/asio/deadline_timer.hpp>
+#include <boost/asio/buffer.hpp>
 #include <boost/asio/io_service.hpp>
 #include <boost/asio/generic/stream_protocol.hpp>
-#include <boost/asio/read_until.hpp>
-#include <boost/asio/streambuf.hpp>
+#include <boost/asio/posix/stream_descriptor.hpp>
 #include <boost/system/system_error.hpp>
 #include <cstdlib>
+#include <functional>
 #include <iostream>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include <msgpack.hpp>
+#include "capture.hpp"
 // #include <msgpack.h>
 namespace nvim {
 
-//TODO Implement asynchronous response handler.
+/// Connection to nvim. Once connected, all I/O is done by IoThread, either
+/// through the non-blocking calls from its Reactor (Linux) or through the
+/// asynchronous ones on io_service().
 class Socket {
 public:
-    Socket() : 
+    Socket() :
         socket_(io_service_),
-        deadline_(io_service_)
+#ifdef BOOST_ASIO_HAS_POSIX_STREAM_DESCRIPTOR
+        stdin_(io_service_),
+        stdout_(io_service_),
+#endif
+        read_hint_(kMinReadSize)
     {
-        deadline_.expires_at(boost::posix_time::pos_infin);
-        check_deadline();
     }
 
-    void connect_tcp(const std::string& host, 
+    /// Blocking connects, failing with timed_out after timeout_sec.
+    void connect_tcp(const std::string& host,
                const std::string& service, double timeout_sec);
     void connect_pipe(const std::string& name, double timeout_sec);
+    /// Talk over stdin/stdout, for a server started by nvim with
+    /// jobstart(cmd, {'rpc': v:true}). stdout then belongs to the channel:
+    /// fd 1 is pointed at stderr so that logging cannot corrupt it.
+    void connect_stdio();
+    /// Take over fd, a local stream socket already connected to nvim, such
+    /// as one accepted by the daemon (tree --daemon).
+    void connect_fd(int fd);
 
-    size_t read(char *rbuf, size_t capacity, double timeout_sec);
-    msgpack::unpacked read2(double timeout_sec);
-    void write(char *sbuf, size_t size, double timeout_sec);
+    /// Record every chunk read or written from now on into path (see
+    /// capture.hpp). Call before connecting.
+    void start_capture(const std::string &path) {
+        capture_.reset(new CaptureWriter(path));
+    }
+
+    using ErrorHandler = std::function<void(const boost::system::error_code &ec)>;
+    using MessageHandler = std::function<void(msgpack::unpacked &&msg)>;
+
+    // Non-blocking interface, for a readiness loop polling the handles.
+    // They are the same but for stdio.
+    int read_handle();
+    int write_handle();
+    void set_non_blocking();
+    /// Read until the socket would block, handing every complete message to
+    /// on_message. Returns would_block once drained, eof or the read error
+    /// otherwise.
+    boost::system::error_code read_messages(const MessageHandler &on_message);
+    /// One writev(); ec is would_block when nothing could be written.
+    size_t write_some(const std::vector<boost::asio::const_buffer> &bufs,
+                      boost::system::error_code &ec);
+
+    // Asynchronous interface, for the thread running io_service().
+    boost::asio::io_service &io_service() { return io_service_; }
+    /// Hand every complete message to on_message until a read fails,
+    /// then call on_error once.
+    void async_read_messages(MessageHandler on_message, ErrorHandler on_error);
+    /// on_done gets a null error_code once all buffers are written.
+    void async_write(const std::vector<boost::asio::const_buffer> &bufs, ErrorHandler on_done);
+
+    void close();
 
 private:
-    void check_deadline();
+    void start_read();
+    void reserve_read_buffer();
+    void update_read_hint(size_t rlen, size_t capacity);
+
+    static const size_t kMinReadSize = 4 * 1024;
+    static const size_t kMaxReadSize = 1024 * 1024;
 
     boost::asio::io_service io_service_;
     boost::asio::generic::stream_protocol::socket socket_;
-    boost::asio::deadline_timer deadline_;
-    boost::asio::streambuf input_buffer_;
+#ifdef BOOST_ASIO_HAS_POSIX_STREAM_DESCRIPTOR
+    boost::asio::posix::stream_descriptor stdin_;
+    boost::asio::posix::stream_descriptor stdout_;
+#endif
+    bool stdio_ = false;
+
+    // Long-lived so that bytes read past the end of one message are kept
+    // for the next read.
+    msgpack::unpacker unpacker_;
+    size_t read_hint_;  // bytes to reserve before the next read
+
+    MessageHandler on_message_;
+    ErrorHandler on_read_error_;
+
+    std::unique_ptr<CaptureWriter> capture_;  // null unless capturing
 };
 
 } //namespace nvim
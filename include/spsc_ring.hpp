@@ -0,0 +1,87 @@
+#ifndef NEOVIM_CPP__SPSC_RING_HPP
+#define NEOVIM_CPP__SPSC_RING_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace nvim {
+
+/// Bounded lock-free queue for exactly one producer and one consumer thread.
+/// Slots are constructed on push and destroyed on pop, so T needs no
+/// default constructor and an empty ring holds no T.
+template<typename T>
+class SpscRing {
+public:
+    /// capacity is rounded up to a power of two.
+    explicit SpscRing(size_t capacity) {
+        size_t n = 1;
+        while (n < capacity)
+            n <<= 1;
+        mask_ = n - 1;
+        slots_.reset(new Storage[n]);
+    }
+
+    ~SpscRing() {
+        size_t head = head_.load(std::memory_order_relaxed);
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        for (; head != tail; ++head)
+            slot(head)->~T();
+    }
+
+    SpscRing(const SpscRing &) = delete;
+    SpscRing &operator=(const SpscRing &) = delete;
+
+    /// Producer only. Returns false, leaving v untouched, when full.
+    bool push(T &&v) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) > mask_)
+            return false;
+        new (slot(tail)) T(std::move(v));
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Consumer only. Returns false when empty.
+    bool pop(T &v) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire))
+            return false;
+        T *p = slot(head);
+        v = std::move(*p);
+        p->~T();
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool empty() const {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+    /// Producer only.
+    bool full() const {
+        return tail_.load(std::memory_order_acquire)
+            - head_.load(std::memory_order_acquire) > mask_;
+    }
+
+    size_t capacity() const { return mask_ + 1; }
+
+private:
+    using Storage = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+
+    T *slot(size_t i) { return reinterpret_cast<T *>(&slots_[i & mask_]); }
+
+    std::unique_ptr<Storage[]> slots_;
+    size_t mask_;
+    // Free-running counters, on separate cache lines so that the two
+    // threads do not invalidate each other's line on every operation.
+    alignas(64) std::atomic<size_t> head_{0};  // next slot to pop
+    alignas(64) std::atomic<size_t> tail_{0};  // next slot to push
+};
+
+} //namespace nvim
+
+#endif //NEOVIM_CPP__SPSC_RING_HPP
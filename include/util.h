@@ -3,4 +3,6 @@
 #include <string>
 #include "msgpack.hpp"
 std::string type_name(const msgpack::type::variant &obj);
+// Text form of obj, for log messages.
+std::string dump(const msgpack::object &obj);
 #endif
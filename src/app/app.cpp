@@ -1,197 +1,331 @@
 #include "app.h"
-#include <cinttypes>
-#include <iostream>
+#include "dispatch.hpp"
+#include "session.h"
+#include <thread>
 
-using std::cout;
-using std::endl;
 using std::string;
 
 namespace tree {
+
+// "hi ..." of every group the columns use, built once per process.
+static const vector<string> &highlight_commands()
+{
+    static const vector<string> cmds = [] {
+        vector<string> cmds;
+        char name[40];
+        char cmd[80];
+        auto hi = [&](const char *color) {
+            sprintf(cmd, "hi %s guifg=%s", name, color);
+            cmds.push_back(cmd);
+        };
+
+        // sprintf(cmd, "silent hi %s guifg=%s", name, cell.color.toStdString().c_str());
+        sprintf(name, "tree_%d_0", FILENAME); // file
+        hi(gui_colors[YELLOW].data());
+        sprintf(name, "tree_%d_1", FILENAME); // dir
+        hi(gui_colors[BLUE].data());
+
+        sprintf(name, "tree_%d", SIZE);
+        hi(gui_colors[GREEN].data());
+
+        sprintf(name, "tree_%d", INDENT);
+        hi("#41535b");
+
+        sprintf(name, "tree_%d", TIME);
+        hi(gui_colors[BLUE].data());
+
+        for (int i = 0; i < 83; ++i) {
+            sprintf(name, "tree_%d_%d", ICON, i);
+            hi(icons[i].second.data());
+        }
+        for (int i = 0; i < 16; ++i) {
+            sprintf(name, "tree_%d_%d", MARK, i);
+            hi(gui_colors[i].data());
+        }
+        for (int i = 0; i < 8; ++i) {
+            sprintf(name, "tree_%d_%d", GIT, i);
+            hi(git_indicators[i].second.data());
+        }
+        return cmds;
+    }();
+    return cmds;
+}
+
 App::App(nvim::Nvim *nvim, int chan_id) : m_nvim(nvim), chan_id(chan_id)
 {
-    char format[] = "%s: %" PRIu64 "\n";
-    printf(format, __FUNCTION__, chan_id);
+    LOG_INFO("%s: channel %d", __FUNCTION__, chan_id);
 
     // call rpcnotify(g:tree#_channel_id, "_tree_start", "/Users/zgp/")
     auto &a = *m_nvim;
     // NOTE: 必须同步调用
     a.set_var("tree#_channel_id", chan_id);
+    // Actions may send their context in the compact form, see Context::update.
+    a.async_set_var("tree#_context_version", 1);
     Tree::api = m_nvim;
 
-    // init highlight
-    char name[40];
-    char cmd[80];
-
-    // sprintf(cmd, "silent hi %s guifg=%s", name, cell.color.toStdString().c_str());
-    sprintf(name, "tree_%d_0", FILENAME); // file
-    sprintf(cmd, "hi %s guifg=%s", name, gui_colors[YELLOW].data());
-    a.command(cmd);
-    sprintf(name, "tree_%d_1", FILENAME); // dir
-    sprintf(cmd, "hi %s guifg=%s", name, gui_colors[BLUE].data());
-    a.command(cmd);
+    // All groups in one nvim_call_atomic. Nothing waits for it: nvim runs
+    // it before anything sent later, the first paint included.
+    nvim::Nvim::Batch batch = a.batch();
+    for (const string &cmd : highlight_commands())
+        batch.command(cmd);
+    batch.send();
+}
 
-    sprintf(name, "tree_%d", SIZE);
-    sprintf(cmd, "hi %s guifg=%s", name, gui_colors[GREEN].data());
-    a.command(cmd);
+App::~App()
+{
+    // A daemon outlives its clients, the trees go with the connection.
+    for (auto &item : trees) {
+        item.second->save_session(true);
+        delete item.second;
+    }
+    for (PendingTree &p : m_pending)
+        delete p.tree;
+}
 
-    sprintf(name, "tree_%d", INDENT);
-    sprintf(cmd, "hi %s guifg=%s", name, "#41535b");
-    a.command(cmd);
+void App::createTree(string &path)
+{
+    if (path.back()=='/')  // path("/foo/bar/").parent_path();    // "/foo/bar"
+        path.pop_back();
 
-    sprintf(name, "tree_%d", TIME);
-    sprintf(cmd, "hi %s guifg=%s", name, gui_colors[BLUE].data());
-    a.command(cmd);
+    Map cfgmap = m_cfgmap;
+    // One round trip for both requests, nvim answers in order so bufnr is
+    // known by the time ns_id is. Nothing blocks on them, the event loop
+    // keeps serving other trees until the answers arrive, and the snapshot
+    // is read and the scan run meanwhile.
+    auto buf = m_nvim->future_create_buf(false, true);
+    auto ns = m_nvim->future_create_namespace("tree_icon");
+    std::shared_ptr<const Snapshot> snap;
+    const string session_file = Config(cfgmap).session_file;
+    if (!session_file.empty())
+        snap = Snapshot::load(session_file, path);
+    // Detached: a tree closed before its scan is done does not wait for it.
+    // Once done it wakes the event loop, which then calls poll().
+    std::promise<void> done;
+    std::shared_future<void> scan = done.get_future().share();
+    std::shared_ptr<nvim::Waker> waker = m_nvim->client_.waker();
+    std::thread([path, cfgmap, snap, waker](std::promise<void> done) {
+        Tree::prefetch(path, cfgmap, snap.get());
+        done.set_value();
+        waker->wake();
+    }, std::move(done)).detach();
 
-    for (int i = 0; i < 83; ++i) {
-        sprintf(name, "tree_%d_%d", ICON, i);
-        sprintf(cmd, "hi %s guifg=%s", name, icons[i].second.data());
-        a.command(cmd);
-    }
-    for (int i = 0; i < 16; ++i) {
-        sprintf(name, "tree_%d_%d", MARK, i);
-        sprintf(cmd, "hi %s guifg=%s", name, gui_colors[i].data());
-        a.command(cmd);
-    }
-    for (int i = 0; i < 8; ++i) {
-        sprintf(name, "tree_%d_%d", GIT, i);
-        sprintf(cmd, "hi %s guifg=%s", name, git_indicators[i].second.data());
-        a.command(cmd);
-    }
+    ns.then([this, buf, path, cfgmap, snap, scan](nvim::Integer ns_id) mutable {
+        // A failed request leaves a zero handle, nvim would read it as the
+        // current buffer.
+        int bufnr = buf.failed() ? 0 : buf.get();
+        if (bufnr == 0 || ns_id <= 0) {
+            LOG_ERROR("%s: could not create the tree buffer", path.c_str());
+            m_nvim->async_execute_lua("require('tree').print_error(...)",
+                                      {"could not create the tree buffer for " + path});
+            return;
+        }
+        setupTree(bufnr, ns_id, path, cfgmap, std::move(snap), std::move(scan));
+    });
 }
 
-void App::createTree(string &path)
+void App::setupTree(int bufnr, int ns_id, const string &path, const Map &cfgmap,
+                    std::shared_ptr<const Snapshot> snap, std::shared_future<void> scan)
 {
-    static int count = 0;
-    auto &b = m_nvim;
+    static thread_local int count = 0;
 
-    int bufnr = b->create_buf(false, true);
     char name[64];
     sprintf(name, "Tree-%d", count);
     string bufname(name);
-    b->async_buf_set_name(bufnr, bufname);
     count++;
 
-    int ns_id = b->create_namespace("tree_icon");
-    if (path.back()=='/')  // path("/foo/bar/").parent_path();    // "/foo/bar"
-        path.pop_back();
-    INFO("bufnr:%d ns_id:%d path:%s\n", bufnr, ns_id, path.c_str());
-
-    Tree &tree = *(new Tree(bufnr, ns_id));
-    trees.insert({bufnr, &tree});
-    treebufs.insert(treebufs.begin(), bufnr);
-    tree.cfg.update(m_cfgmap);
-
-    m_ctx.prev_bufnr = bufnr;
-    tree.changeRoot(path);
-
-    b->async_buf_set_option(bufnr, "buflisted", tree.cfg.listed);
-    nvim::Dictionary tree_cfg{
-        {"winwidth", tree.cfg.winwidth},
-        {"winheight", tree.cfg.winheight},
-        {"split", tree.cfg.split.c_str()},
-        {"new", tree.cfg.new_},
-        {"toggle", tree.cfg.toggle},
-        {"direction", tree.cfg.direction.c_str()},
-        {"winrow", tree.cfg.winrow},
-        {"wincol", tree.cfg.wincol},
-    };
-    b->execute_lua("tree.resume(...)", {m_ctx.prev_bufnr, tree_cfg});
+    LOG_DEBUG("bufnr:%d ns_id:%d path:%s\n", bufnr, ns_id, path.c_str());
+
+    Tree *tree = new Tree(bufnr, ns_id, bufname);
+    tree->cfg.update(cfgmap);
+    if (snap) {
+        // On screen before the scan is done, changeRoot() then sends only
+        // what changed since.
+        tree->restore(*snap);
+        tree->resume();
+        tree->flush();
+    }
+    m_pending.push_back({tree, path, std::move(snap), std::move(scan), {}});
+    // A small directory is often scanned by now.
+    poll();
 }
 
-void App::handleNvimNotification(const string &method, const vector<nvim::Object> &args)
+void App::poll()
 {
-    INFO("method: %s\n", method.c_str());
-
-    if(method=="_tree_async_action" && args.size() > 0) {
-        // _tree_async_action [action: string, args: vector, context: multimap]
-        string action = args.at(0).as_string();
-        vector<nvim::Object> act_args = args.at(1).as_vector();
-        auto context = args.at(2).as_multimap();
-        for (auto i : args[2].as_multimap()) {
-            cout << i.first.as_string() << ':';
+    for (auto it = m_pending.begin(); it != m_pending.end();) {
+        if (it->scan.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            ++it;
+            continue;
         }
-        cout << endl;
+        PendingTree p = std::move(*it);
+        it = m_pending.erase(it);
+        finishTree(p);
+    }
+}
+
+void App::finishTree(PendingTree &p)
+{
+    Tree &tree = *p.tree;
+    trees.insert({tree.bufnr, &tree});
+    treebufs.insert(treebufs.begin(), tree.bufnr);
 
-        // INFO("\taction: %s\n", action.c_str());
-        m_ctx = context;
-        // INFO("\tprev_bufnr: %d\n", m_ctx.prev_bufnr);
+    m_ctx.prev_bufnr = tree.bufnr;
+    if (p.snap) {
+        tree.changeRoot(p.path, &p.snap->lines);
+    }
+    else {
+        tree.changeRoot(p.path);
+        tree.resume();
+    }
+    // Buffer setup, lines, highlights and the window in one nvim_call_atomic.
+    tree.flush();
 
-        auto search = trees.find(m_ctx.prev_bufnr);
-        if (search != trees.end()) {
-            // if (action == "quit" && args.size() > 0)
-            search->second->action(action, act_args, context);
-        }
+    for (QueuedAction &a : p.actions)
+        doAction(a.action, a.args.get(), a.context.get());
+}
+
+App::PendingTree *App::findPending(int bufnr)
+{
+    for (PendingTree &p : m_pending) {
+        if (p.tree->bufnr == bufnr)
+            return &p;
+    }
+    return nullptr;
+}
+
+void App::idle()
+{
+    for (auto &item : trees)
+        item.second->save_session(false);
+}
+
+static msgpack::unpacked copy(const nvim::ObjectRef &obj)
+{
+    msgpack::sbuffer sbuf;
+    msgpack::pack(sbuf, obj.object());
+    return msgpack::unpack(sbuf.data(), sbuf.size());
+}
+
+Tree &App::findTree(int bufnr)
+{
+    auto search = trees.find(bufnr);
+    if (search == trees.end() && findPending(bufnr))
+        throw rpc::BadArgs("tree in buffer " + std::to_string(bufnr) + " is still loading");
+    if (search == trees.end())
+        throw rpc::BadArgs("no tree in buffer " + std::to_string(bufnr));
+    return *search->second;
+}
+
+void App::doAction(boost::string_ref action, const nvim::ObjectRef &args,
+                   const nvim::ObjectRef &context)
+{
+    m_ctx.update(context);
+    // LOG_DEBUG("\tprev_bufnr: %d\n", m_ctx.prev_bufnr);
+
+    auto search = trees.find(m_ctx.prev_bufnr);
+    if (search != trees.end()) {
+        // if (action == "quit" && args.size() > 0)
+        search->second->action(action, args, m_ctx);
+    }
+    else if (PendingTree *p = findPending(m_ctx.prev_bufnr)) {
+        // Painted from a snapshot and usable already, the model comes with
+        // the scan.
+        p->actions.push_back({action.to_string(), copy(args), copy(context)});
+    }
+}
+
+void App::handleNvimNotification(boost::string_ref method, const nvim::ObjectRef &args)
+{
+    LOG_DEBUG("method: %.*s\n", (int)method.size(), method.data());
+    nvim::ScopedStats record(m_stats, method, m_nvim->client_.bytes_sent());
+
+    switch (rpc::find_notification(method)) {
+    case rpc::Notification::kTreeAsyncAction: {
+        rpc::TreeAsyncActionArgs a(args);
+        doAction(a.action, a.args, a.context);
+        break;
     }
-    else if (method=="function") {
-        string fn = args.at(0).as_string();
+    case rpc::Notification::kFunction: {
+        rpc::FunctionArgs f(args);
         // TODO The logic of tree.nvim calling lua code and then calling back cpp code should be placed in tree.cpp
-        if (fn == "paste") {
-            vector<nvim::Object> fargs = args.at(1).as_vector();
-            vector<nvim::Object> pos = fargs[0].as_vector();
-            string src = fargs[1].as_string();
-            string dest = fargs[2].as_string();
-            int buf = pos[0].as_uint64_t();
-            int line = pos[1].as_uint64_t();
-            trees[buf]->paste(line, src, dest);
+        switch (rpc::find_function(f.name)) {
+        case rpc::Function::kPaste: {
+            rpc::FunctionPasteArgs a(f.args);
+            findTree(a.pos.buf).paste(a.pos.line, a.src.to_string(), a.dest.to_string());
+            break;
         }
-        else if (fn == "new_file") {
-            vector<nvim::Object> fargs = args.at(1).as_vector();
-            string input = fargs[0].as_string();
-            int bufnr = fargs[1].as_uint64_t();
-            trees[bufnr]->handleNewFile(input);
+        case rpc::Function::kNewFile: {
+            rpc::FunctionNewFileArgs a(f.args);
+            findTree(a.bufnr).handleNewFile(a.input.to_string());
+            break;
         }
-        else if (fn == "rename") {
-            vector<nvim::Object> fargs = args.at(1).as_vector();
-            string input = fargs[0].as_string();
-            int bufnr = fargs[1].as_uint64_t();
-            trees[bufnr]->handleRename(input);
+        case rpc::Function::kRename: {
+            rpc::FunctionRenameArgs a(f.args);
+            string input = a.input.to_string();
+            findTree(a.bufnr).handleRename(input);
+            break;
         }
-        else if (fn == "remove") {
-            vector<nvim::Object> fargs = args.at(1).as_vector();
-            int buf = fargs[0].as_uint64_t();
-            int choice = fargs[1].as_uint64_t();
-            trees[buf]->remove();
+        case rpc::Function::kRemove: {
+            rpc::FunctionRemoveArgs a(f.args);
+            findTree(a.buf).remove();
+            break;
         }
-        else if (fn == "on_detach") {
-            const int buf = args.at(1).as_uint64_t();
-            auto got = trees.find(buf);
+        case rpc::Function::kOnDetach: {
+            rpc::FunctionOnDetachArgs a(f.args);
+            auto pending = std::find_if(m_pending.begin(), m_pending.end(),
+                    [&a](const PendingTree &p) { return p.tree->bufnr == a.buf; });
+            if (pending != m_pending.end()) {
+                delete pending->tree;
+                m_pending.erase(pending);
+            }
+            auto got = trees.find(a.buf);
             if (got != trees.end()) {
-                delete trees[buf];
-                trees.erase(buf);
+                got->second->save_session(true);
+                delete got->second;
+                trees.erase(got);
                 // TODO: 修改tree_buf
-                printf("\tAfter remove %d, trees:", buf);
-                for (auto i:trees) {
-                    cout << i.first << ",";
-                }
-                cout << endl;
+                LOG_DEBUG("after removing %d, %zu trees", (int)a.buf, trees.size());
             }
+            break;
         }
+        case rpc::Function::kUnknown:
+            throw rpc::BadArgs("function: unknown name " + f.name.to_string());
+        }
+        break;
+    }
+    case rpc::Notification::kUnknown:
+        break;
     }
 }
 
-void App::handleRequest(nvim::NvimRPC & rpc, uint64_t msgid, const string& method,
-        const vector<nvim::Object> &args)
+void App::handleRequest(nvim::NvimRPC & client, uint64_t msgid, boost::string_ref method,
+        const nvim::ObjectRef &args)
 {
-    INFO("method: %s args.size: %lu\n", method.c_str(), args.size());
+    LOG_DEBUG("method: %.*s\n", (int)method.size(), method.data());
+    nvim::ScopedStats record(m_stats, method, client.bytes_sent());
 
-    if(method=="_tree_start" && args.size() > 0)
-    {
-        // _tree_start [paths: List, context: Dictionary]
-        auto paths = args[0].as_vector();
+    switch (rpc::find_request(method)) {
+    case rpc::Request::kTreeStart: {
+        rpc::TreeStartArgs a(args);
         // TODO: 支持path列表(多个path源)
-        string path = paths[0].as_string();
-        m_cfgmap = args[1].as_multimap();
+        string path = a.paths.at(0).as_string();
+        // Kept for trees created later, so this one is copied out.
+        m_cfgmap.clear();
+        a.context.convert(m_cfgmap);
         auto *b = m_nvim;
 
         auto search = m_cfgmap.find("new");
-        if (trees.size()<1 || (search != m_cfgmap.end() && search->second.as_bool())) {
-            // TODO: createTree时存在request和此处的response好像产生冲突
+        if ((trees.empty() && m_pending.empty()) ||
+                (search != m_cfgmap.end() && search->second.as_bool())) {
+            // Answered right away, the tree shows up when it is scanned.
             createTree(path);
         }
+        else if (trees.empty()) {
+            // Only trees still being scanned, they open once done.
+        }
         else {
             // NOTE: Resume tree buffer by default.
             // TODO: consider to use treebufs[0]
-            Tree & tree = *trees[m_ctx.prev_bufnr];
+            Tree & tree = findTree(m_ctx.prev_bufnr);
 
             auto it = std::find(treebufs.begin(), treebufs.end(), m_ctx.prev_bufnr);
             if (it != treebufs.end()) {
@@ -225,16 +359,87 @@ void App::handleRequest(nvim::NvimRPC & rpc, uint64_t msgid, const string& metho
             // TODO: columns 状态更新需要清除不需要的columns
         }
 
-        rpc.send_response(msgid, {}, {});
-    } else if(method=="_tree_get_candidate") {
-        Map context = args[0].as_multimap();
-        Tree & tree = *trees[m_ctx.prev_bufnr];
-        auto search = context.find("cursor");
-        auto rv = tree.get_candidate(search->second.as_uint64_t()-1);
-        rpc.send_response(msgid, {}, rv);
-    } else {
-        // be sure to return early or this message will be sent
-        rpc.send_response(msgid, {"Unknown method"}, {});
+        client.send_response(msgid, {}, {});
+        break;
+    }
+    case rpc::Request::kTreeGetCandidate: {
+        rpc::TreeGetCandidateArgs a(args);
+        // The context names the tree when it has prev_bufnr, otherwise the
+        // last action's tree it is.
+        Context ctx = m_ctx;
+        ctx.update(a.context);
+        Tree & tree = findTree(ctx.prev_bufnr);
+        auto rv = tree.get_candidate(ctx.cursor-1);
+        client.send_response(msgid, {}, rv);
+        break;
+    }
+    case rpc::Request::kTreeDoAction: {
+        // Same as _tree_async_action, answered once the action is done.
+        rpc::TreeDoActionArgs a(args);
+        doAction(a.action, a.args, a.context);
+        client.send_response(msgid, {}, {});
+        break;
+    }
+    case rpc::Request::kTreeStats:
+        client.send_response(msgid, {}, stats());
+        break;
+    case rpc::Request::kTreeLogLevel: {
+        rpc::TreeLogLevelArgs a(args);
+        nvim::LogLevel level;
+        if (!nvim::Logger::parse_level(a.level, level))
+            throw rpc::BadArgs("_tree_log_level: unknown level " + a.level.to_string());
+        nvim::Logger::set_level(level);
+        client.send_response(msgid, {}, {});
+        break;
+    }
+    case rpc::Request::kUnknown:
+        client.send_response(msgid, {"Unknown method"}, {});
+        break;
+    }
+}
+
+static nvim::Dictionary to_dictionary(const nvim::MethodStats &stats)
+{
+    nvim::Dictionary methods;
+    for (const auto &item : stats.entries()) {
+        const nvim::MethodStats::Entry &e = item.second;
+        // [[upper bound in us, calls], ...] of the non-empty buckets, nvim
+        // only takes string keys.
+        nvim::Array histogram;
+        for (size_t i = 0; i < nvim::MethodStats::kBuckets; ++i) {
+            if (e.buckets[i] == 0)
+                continue;
+            uint64_t bound = i + 1 < nvim::MethodStats::kBuckets ?
+                nvim::MethodStats::Entry::bucket_bound_us(i) : e.max_us;
+            histogram.push_back(nvim::Array{bound, e.buckets[i]});
+        }
+        methods.insert({item.first, nvim::Dictionary{
+            {"count", e.count},
+            {"bytes", e.bytes},
+            {"total_us", e.total_us},
+            {"max_us", e.max_us},
+            {"avg_us", e.timed ? e.total_us / e.timed : 0},
+            {"latency_us", histogram},
+        }});
     }
+    return methods;
 }
+
+nvim::Dictionary App::stats() const
+{
+    const nvim::NvimRPC &rpc = m_nvim->client_;
+    const nvim::BufferPool::Stats &pool = rpc.buffer_stats();
+    return nvim::Dictionary{
+        {"outgoing", to_dictionary(rpc.method_stats())},
+        {"requests", to_dictionary(m_stats)},
+        {"actions", to_dictionary(Tree::action_stats)},
+        {"bytes_sent", rpc.bytes_sent()},
+        {"queued_bytes", uint64_t(rpc.queued_bytes())},
+        {"buffer_pool", nvim::Dictionary{
+            {"hits", pool.hits},
+            {"misses", pool.misses},
+        }},
+    };
+}
+
 } // namespace tree
@@ -1,6 +1,8 @@
 #ifndef NVIM_CPP_APP
 #define NVIM_CPP_APP
 
+#include <future>
+#include <memory>
 #include <tuple>
 #include "tree.h"
 #include "nvim.hpp"
@@ -11,14 +13,57 @@ class App
 {
 public:
     App(nvim::Nvim *, int);
+    ~App();
 
     void createTree(string &path);
-    void handleNvimNotification(const string &method, const vector<nvim::Object> &args);
-    void handleRequest(nvim::NvimRPC & rpc, uint64_t msgid, const string& method, const vector<nvim::Object> &args);
+    // Called by the event loop: finish the trees whose scan is done. A scan
+    // that finishes wakes the loop through the client's waker().
+    void poll();
+    // Called by the event loop when there is nothing to read.
+    void idle();
+    // args are views into the received message, valid during the call only.
+    void handleNvimNotification(boost::string_ref method, const nvim::ObjectRef &args);
+    void handleRequest(nvim::NvimRPC & client, uint64_t msgid, boost::string_ref method, const nvim::ObjectRef &args);
 
 private:
+    // An action on a tree that is on screen but still scanned.
+    struct QueuedAction {
+        string action;
+        // Copies, the message they came with is gone when they run.
+        msgpack::unpacked args;
+        msgpack::unpacked context;
+    };
+    // Created but not scanned yet, not in trees until finishTree().
+    struct PendingTree {
+        Tree *tree;
+        string path;
+        std::shared_ptr<const Snapshot> snap;
+        std::shared_future<void> scan;
+        // Run by finishTree(), in order.
+        vector<QueuedAction> actions;
+    };
+    // Buffer and namespace are there. The tree waits in m_pending for its
+    // scan, painted from snap meanwhile if there is one.
+    void setupTree(int bufnr, int ns_id, const string &path, const Map &cfgmap,
+                   std::shared_ptr<const Snapshot> snap, std::shared_future<void> scan);
+    // The scan is done: build the model, paint, make the tree known, then
+    // run the actions queued meanwhile.
+    void finishTree(PendingTree &p);
+    // nullptr when bufnr holds no tree being scanned.
+    PendingTree *findPending(int bufnr);
+    // Reply of _tree_stats: {outgoing, requests, actions} by method name,
+    // plus the state of the outgoing buffers.
+    nvim::Dictionary stats() const;
+    // _tree_async_action and _tree_do_action
+    void doAction(boost::string_ref action, const nvim::ObjectRef &args,
+                  const nvim::ObjectRef &context);
+    // Throws rpc::BadArgs when bufnr holds no tree, or one still scanned.
+    Tree &findTree(int bufnr);
+
     nvim::Nvim *m_nvim;
     int chan_id;
+    // Inbound requests and notifications.
+    nvim::MethodStats m_stats;
 
     Context m_ctx;
     Map m_cfgmap;
@@ -26,6 +71,7 @@ private:
     // unordered_map<string, QVariant> resource;
     unordered_map<int, Tree*> trees;
     list<int> treebufs;  // Recently used order
+    vector<PendingTree> m_pending;
 };
 
 } // namespace tree
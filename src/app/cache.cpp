@@ -0,0 +1,91 @@
+#include "cache.h"
+#include <algorithm>
+#include "strnatcmp.hpp"
+
+using namespace boost::filesystem;
+using std::string;
+
+namespace tree {
+
+DirCache dir_cache;
+GitCache git_cache;
+
+const size_t DirCache::kMaxItems;
+constexpr std::chrono::seconds GitCache::kTtl;
+
+std::shared_ptr<const DirListing> DirCache::list(const path &dir)
+{
+    const string key = dir.string();
+    const std::time_t mtime = last_write_time(dir);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = items_.find(key);
+        if (it != items_.end() && it->second.mtime == mtime)
+            return it->second.listing;
+    }
+
+    auto listing = std::make_shared<DirListing>();
+    for (directory_iterator it(dir), end; it != end; ++it) {
+        boost::system::error_code ec;
+        bool is_dir = is_directory(it->status(ec));
+        listing->push_back({it->path(), is_dir});
+    }
+    sort(listing->begin(), listing->end(), [](const DirEntry &x, const DirEntry &y) {
+        if (x.is_dir == y.is_dir)
+            return compareNat(x.p.string(), y.p.string());
+        else
+            return x.is_dir > y.is_dir;
+    });
+
+    // mtime has a resolution of one second: a directory changed during the
+    // second it was listed in could change again without a new mtime.
+    if (mtime < std::time(nullptr) - 1) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (items_.size() >= kMaxItems)
+            items_.clear();
+        items_[key] = Item{mtime, listing};
+    }
+    return listing;
+}
+
+std::shared_ptr<const DirListing> DirCache::find(const string &dir, std::time_t &mtime)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = items_.find(dir);
+    if (it == items_.end())
+        return nullptr;
+    mtime = it->second.mtime;
+    return it->second.listing;
+}
+
+void DirCache::seed(const string &dir, std::time_t mtime,
+                    std::shared_ptr<const DirListing> listing)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (items_.size() >= kMaxItems)
+        items_.clear();
+    items_.insert({dir, Item{mtime, std::move(listing)}});
+}
+
+std::shared_ptr<const GitMap> GitCache::status(const string &dir,
+                                               const std::function<GitMap()> &load,
+                                               Clock::time_point not_before)
+{
+    std::shared_ptr<Item> item;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::shared_ptr<Item> &slot = items_[dir];
+        if (!slot)
+            slot = std::make_shared<Item>();
+        item = slot;
+    }
+
+    std::lock_guard<std::mutex> lock(item->mutex);
+    if (!item->map || item->started < not_before) {
+        item->started = Clock::now();
+        item->map = std::make_shared<const GitMap>(load());
+    }
+    return item->map;
+}
+
+} // namespace tree
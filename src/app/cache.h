@@ -0,0 +1,86 @@
+#ifndef NVIM_CPP_CACHE
+#define NVIM_CPP_CACHE
+
+#include <chrono>
+#include <ctime>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <boost/filesystem.hpp>
+#include "column.h"
+
+namespace tree {
+
+/// Caches shared by every client of the process. In daemon mode several
+/// nvim instances are served from one process, so the second editor on a
+/// checkout finds its directories and git status already loaded. Entries
+/// are immutable once published; readers keep a shared_ptr and never lock.
+
+struct DirEntry {
+    boost::filesystem::path p;
+    bool is_dir;
+};
+// Directories first, then natural order, as the tree shows them.
+using DirListing = std::vector<DirEntry>;
+
+class DirCache
+{
+public:
+    /// The entries of dir, sorted. A listing is reused while the mtime of
+    /// dir is unchanged. Throws like boost::filesystem::directory_iterator.
+    std::shared_ptr<const DirListing> list(const boost::filesystem::path &dir);
+    /// The cached listing of dir and the mtime it was read at, nullptr if
+    /// there is none. The disk is not looked at.
+    std::shared_ptr<const DirListing> find(const std::string &dir, std::time_t &mtime);
+    /// Publish a listing read elsewhere, list() still checks it against
+    /// the mtime of dir. A listing already cached for dir is kept.
+    void seed(const std::string &dir, std::time_t mtime,
+              std::shared_ptr<const DirListing> listing);
+
+private:
+    struct Item {
+        std::time_t mtime;
+        std::shared_ptr<const DirListing> listing;
+    };
+    // Dropped all at once when reached, a crude bound for long-lived daemons.
+    static const size_t kMaxItems = 1 << 16;
+
+    std::mutex mutex_;
+    std::unordered_map<std::string, Item> items_;
+};
+
+class GitCache
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    // git status has no cheap validator, so results are only reused to
+    // warm up a tree being created: the prefetch and the first paint, or
+    // another client opening the same checkout shortly after.
+    static constexpr std::chrono::seconds kTtl{10};
+
+    /// The status map of the work tree containing dir. It is reused when
+    /// its load started at not_before or later, load computes it otherwise.
+    /// Concurrent callers for the same dir wait for one load.
+    std::shared_ptr<const GitMap> status(const std::string &dir,
+                                         const std::function<GitMap()> &load,
+                                         Clock::time_point not_before);
+
+private:
+    struct Item {
+        std::mutex mutex;  // held while loading
+        Clock::time_point started;  // of the load that produced map
+        std::shared_ptr<const GitMap> map;
+    };
+
+    std::mutex mutex_;
+    std::unordered_map<std::string, std::shared_ptr<Item>> items_;
+};
+
+extern DirCache dir_cache;
+extern GitCache git_cache;
+
+} // namespace tree
+#endif
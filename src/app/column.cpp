@@ -1,7 +1,8 @@
 #include "column.h"
+#include "cache.h"
+#include "log.hpp"
 #include "util.h"
 #include <boost/process.hpp>
-#include <iostream>
 
 using namespace std;
 using namespace boost::filesystem;
@@ -110,7 +111,7 @@ Cell::Cell(const Config &cfg, const FileItem& fileitem, const int type)
             text = " ";
         }
         else {
-            text = mark_indicators["readonly_icon"];
+            text = mark_indicators.at("readonly_icon");
             color = BROWN;
         }
     }
@@ -163,12 +164,19 @@ Cell::Cell(const Config &cfg, const FileItem& fileitem, const int type)
     else if (type == TIME) {
         try {
             std::time_t t = boost::filesystem::last_write_time(fileitem.p);;
+            std::tm tm;
             char mbstr[64];
-            if (std::strftime(mbstr, sizeof(mbstr), cfg.time_format.c_str(), std::localtime(&t))) {
+            // Not localtime(), its result is shared between threads.
+#ifdef _WIN32
+            localtime_s(&tm, &t);
+#else
+            localtime_r(&t, &tm);
+#endif
+            if (std::strftime(mbstr, sizeof(mbstr), cfg.time_format.c_str(), &tm)) {
                 text = mbstr;
             }
         } catch(std::exception& e) {
-            cout << "------->" << e.what() << endl;
+            LOG_WARN("%s", e.what());
         }
         color = BLUE;
     }
@@ -180,14 +188,16 @@ Cell::~Cell()
 }
 
 
-unordered_map<string, git_status> FileItem::git_map;
+thread_local std::shared_ptr<const GitMap> FileItem::git_map;
 void Cell::update_git(const FileItem &fi)
 {
     text = " ";
+    if (!FileItem::git_map)
+        return;
     string path = fi.p.string();
     // cout << "query:" << path;
-    auto search = FileItem::git_map.find(path);
-    if (search != FileItem::git_map.end()) {
+    auto search = FileItem::git_map->find(path);
+    if (search != FileItem::git_map->end()) {
         auto key = search->second;
         text = git_indicators[key].first;
         color = key;
@@ -281,10 +291,10 @@ git_status get_indicator_name(const char X, const char Y)
         return Unknown;
 }
 
-void FileItem::update_gmap(string p)
+static GitMap load_git_map(const string &p)
 {
     using namespace boost::process;
-    FileItem::git_map.clear();
+    GitMap git_map;
 
     ipstream pipe_stream;
     string cmd1 = "git -C " + p + " rev-parse --show-toplevel";
@@ -292,20 +302,18 @@ void FileItem::update_gmap(string p)
 
     string line;
 
-    if (pipe_stream && std::getline(pipe_stream, line) && !line.empty())
-        cerr << line << endl;
+    std::getline(pipe_stream, line);
     if (line=="")
-        return;
+        return git_map;
     string topdir((path(line)+=path::preferred_separator).string());
-    cout << __FUNCTION__ << " top dir: " << topdir << endl;
+    LOG_DEBUG("%s top dir: %s", __FUNCTION__, topdir.c_str());
 
     ipstream pipe_stream2;
     string cmd2 = "git -C " + p + " status --porcelain -u";
-    cerr << cmd2 << endl;
+    LOG_DEBUG("%s", cmd2.c_str());
     child c2(cmd2, std_out > pipe_stream2);
     vector<string> lines;
     while (pipe_stream2 && std::getline(pipe_stream2, line) && !line.empty()) {
-        cerr << line << endl;
         lines.push_back(line);
     }
     c.wait();
@@ -321,36 +329,65 @@ void FileItem::update_gmap(string p)
         if (status == Renamed) {
             std::string::size_type n = line.find(" -> ");
             string key = topdir + line.substr(n+4);
-            FileItem::git_map[key] = status;
+            git_map[key] = status;
         }
         else {
             string key = topdir + line.substr(3);
-            cout << key << endl;
-            FileItem::git_map[key] = status;
+            git_map[key] = status;
         }
     }
+    return git_map;
 }
 
-Context::Context(const Map &ctx)
+void FileItem::update_gmap(string p, bool warm)
 {
-    for (auto i : ctx) {
-        auto k = i.first.as_string();
-        auto v = i.second;
+    auto now = GitCache::Clock::now();
+    git_map = git_cache.status(p, [&p] { return load_git_map(p); },
+                               warm ? now - GitCache::kTtl : now);
+}
+
+void FileItem::preload_gmap(const string &p)
+{
+    git_cache.status(p, [&p] { return load_git_map(p); },
+                     GitCache::Clock::now() - GitCache::kTtl);
+}
+
+Context::Context(const nvim::ObjectRef &ctx)
+{
+    update(ctx);
+}
+
+void Context::update(const nvim::ObjectRef &ctx)
+{
+    if (ctx.is_array()) {
+        if (ctx.size() < 5)
+            throw std::invalid_argument("context: expected [cursor, prev_bufnr, prev_winid, visual_start, visual_end]");
+        cursor = ctx.at(0).as_int();
+        prev_bufnr = ctx.at(1).as_int();
+        prev_winid = ctx.at(2).as_int();
+        visual_start = ctx.at(3).as_int();
+        visual_end = ctx.at(4).as_int();
+        return;
+    }
+    ctx.for_each_pair([this](const nvim::ObjectRef &key, const nvim::ObjectRef &v) {
+        boost::string_ref k = key.as_string_ref();
         if (k == "prev_bufnr") {
-            prev_bufnr = v.as_uint64_t();
+            prev_bufnr = v.as_int();
         }else if (k == "cursor") {
-            cursor = v.as_uint64_t();
+            cursor = v.as_int();
         }else if (k == "prev_winid") {
-            prev_winid = v.as_uint64_t();
+            prev_winid = v.as_int();
         }else if (k == "visual_start") {
-            visual_start = v.as_uint64_t();
+            visual_start = v.as_int();
         }else if (k == "visual_end") {
-            visual_end = v.as_uint64_t();
+            visual_end = v.as_int();
+        }else if (k == "drives") {
+            // Always empty.
         }
         else{
-            cout<<"Unsupported member: "<<k <<endl;
+            LOG_WARN("Unsupported member: %.*s", (int)k.size(), k.data());
         }
-    }
+    });
 }
 
 // https://www.zhihu.com/question/36642771
@@ -481,7 +518,7 @@ void Config::update(const Map &ctx)
             }
         }
         else{
-            cout<<"Unsupported member: "<<k<<endl;
+            LOG_DEBUG("Unsupported member: %s", k.c_str());
         }
     }
 }
@@ -1,6 +1,8 @@
 #ifndef NVIM_COLUMN_H
 #define NVIM_COLUMN_H
 #include "msgpack.hpp" // msgpack::type::variant
+#include "object_ref.hpp"
+#include <memory>
 #include <unordered_map>
 #include <string>
 #include <array>
@@ -19,6 +21,7 @@ extern string gui_colors[];
 enum GUI_COLOR { BROWN, AQUA, BLUE, DARKBLUE, PURPLE, LIGHTPURPLE, RED, BEIGE, YELLOW, ORANGE, DARKORANGE, PINK, SALMON, GREEN, LIGHTGREEN, WHITE };
 enum column {MARK, INDENT, GIT, ICON, FILENAME, SIZE, TIME};
 enum git_status {Untracked, Modified, Staged, Renamed, Ignored, Unmerged, Deleted, Unknown};
+using GitMap = unordered_map<string, git_status>;
 
 class Cell;
 class Config;
@@ -40,8 +43,13 @@ public:
     bool selected = false;
     const FileItem* parent=nullptr;
     bool last = false;
-    static unordered_map<string, git_status> git_map;
-    static void update_gmap(string p);
+    // Status of the client's current root, through the process-wide git_cache.
+    static thread_local std::shared_ptr<const GitMap> git_map;
+    // Runs git status, unless warm and git_cache has a recent result.
+    static void update_gmap(string p, bool warm = false);
+    // Fill git_cache for p and leave git_map alone, for any thread. A
+    // recent result is kept.
+    static void preload_gmap(const string &p);
 };
 
 /// 多个column类意义不大，管理困难
@@ -71,7 +79,11 @@ struct Context
 {
     // FIXME: 默认构造的成员初始值没有意义
     Context(){};
-    Context(const Map &ctx);
+    Context(const nvim::ObjectRef &ctx);
+    /// Takes the compact form [cursor, prev_bufnr, prev_winid,
+    /// visual_start, visual_end] sent with every action, or a map of any of
+    /// the members. Nothing is allocated for the compact form.
+    void update(const nvim::ObjectRef &ctx);
     int cursor = 0;
     list<string> drives;
     int prev_bufnr = 0;
@@ -0,0 +1,196 @@
+#include "eventloop.h"
+#include "app.h"
+#include "dispatch.hpp"
+#include "log.hpp"
+#include "util.h"
+#include <deque>
+#include <string>
+
+using std::string;
+
+namespace tree {
+namespace {
+
+// Messages read but not served yet, in two lanes.
+//
+// nvim is blocked in rpcrequest() until a request is answered, so a request
+// always comes after the notifications nvim sent before it and may depend on
+// them: _tree_get_candidate reads the tree as the preceding _tree_async_action
+// left it, _tree_start must not resume a buffer a queued on_detach closed.
+// Requests and the notifications the app acts on (_tree_async_action and
+// function) therefore share one lane and are served in arrival order. Only
+// notifications nobody handles wait in the other lane, and every request
+// jumps them.
+struct Lanes {
+    std::deque<msgpack::unpacked> ordered;
+    std::deque<msgpack::unpacked> other;
+
+    bool empty() const { return ordered.empty() && other.empty(); }
+
+    void push(msgpack::unpacked &&msg) {
+        const msgpack::object &obj = msg.get();
+        if (obj.type != msgpack::type::ARRAY || obj.via.array.size == 0 ||
+                obj.via.array.ptr[0].type != msgpack::type::POSITIVE_INTEGER) {
+            LOG_ERROR("Received Invalid msgpack: %s", dump(obj).c_str());
+            return;
+        }
+        uint64_t type = obj.via.array.ptr[0].via.u64;
+        if (type == 0)
+            ordered.push_back(std::move(msg));
+        else if (type == 2)
+            (handled(obj) ? ordered : other).push_back(std::move(msg));
+        else
+            LOG_ERROR("Unsupported msg type %llu", (unsigned long long)type);
+    }
+
+    msgpack::unpacked pop() {
+        auto &lane = ordered.empty() ? other : ordered;
+        msgpack::unpacked msg = std::move(lane.front());
+        lane.pop_front();
+        return msg;
+    }
+
+private:
+    // A notification App::handleNvimNotification acts on. Malformed ones
+    // keep their place too, dispatch() reports them.
+    static bool handled(const msgpack::object &obj) {
+        if (obj.via.array.size < 2 ||
+                (obj.via.array.ptr[1].type != msgpack::type::BIN &&
+                 obj.via.array.ptr[1].type != msgpack::type::STR))
+            return true;
+        return rpc::find_notification(nvim::ObjectRef(obj.via.array.ptr[1]).as_string_ref())
+            != rpc::Notification::kUnknown;
+    }
+};
+
+// obj is an array led by its type, as checked by Lanes::push(). A bad
+// message is logged, and answered with an error when it has a msgid.
+void dispatch(nvim::Nvim &nvim, tree::App &app, const msgpack::object &obj)
+{
+    uint64_t type = obj.via.array.ptr[0].via.u64;
+
+    switch(type) {
+    case 0:
+        if (obj.via.array.size < 2 ||
+                obj.via.array.ptr[1].type != msgpack::type::POSITIVE_INTEGER) {
+            LOG_ERROR("Received Invalid request: msg id MUST be a positive integer %s",
+                      dump(obj).c_str());
+            break;
+        }
+        if (obj.via.array.size != 4 ||
+                (obj.via.array.ptr[2].type != msgpack::type::BIN &&
+                 obj.via.array.ptr[2].type != msgpack::type::STR) ||
+                obj.via.array.ptr[3].type != msgpack::type::ARRAY) {
+            LOG_ERROR("Received Invalid request: %s", dump(obj).c_str());
+            nvim.client_.send_response(obj.via.array.ptr[1].via.u64, {"Invalid request"}, {});
+            break;
+        }
+        {
+            // [type(0), msgid, method, params]
+            const msgpack::object *a = obj.via.array.ptr;
+            uint64_t msgid = a[1].via.u64;
+            nvim::ObjectRef method(a[2]);
+            nvim::ObjectRef argv(a[3]);
+            boost::string_ref name = method.as_string_ref();
+            LOG_DEBUG("request %llu: %.*s", (unsigned long long)msgid, (int)name.size(), name.data());
+
+            // 涉及 tree.nvim 通信协议
+            auto args = argv.size() > 0 ? argv.at(0) : nvim::ObjectRef();
+
+            try {
+                app.handleRequest(nvim.client_, msgid, name, args);
+            } catch (std::exception &e) {
+                // Arguments of an unexpected type, do not leave nvim waiting.
+                LOG_WARN("%.*s: %s", (int)name.size(), name.data(), e.what());
+                nvim.client_.send_response(msgid, {e.what()}, {});
+            }
+        }
+        break;
+    case 2:
+        if (obj.via.array.size != 3 ||
+                (obj.via.array.ptr[1].type != msgpack::type::BIN &&
+                 obj.via.array.ptr[1].type != msgpack::type::STR) ||
+                obj.via.array.ptr[2].type != msgpack::type::ARRAY) {
+            LOG_ERROR("Received Invalid notification: %s", dump(obj).c_str());
+            break;
+        }
+        {
+            // [type(2), method, params]
+            nvim::ObjectRef method(obj.via.array.ptr[1]);
+            nvim::ObjectRef argv(obj.via.array.ptr[2]);
+            boost::string_ref name = method.as_string_ref();
+            LOG_DEBUG("notification: %.*s", (int)name.size(), name.data());
+
+            // 涉及 tree.nvim 通信协议
+            auto args = argv.size() > 0 ? argv.at(0) : nvim::ObjectRef();
+
+            try {
+                app.handleNvimNotification(name, args);
+            } catch (std::exception &e) {
+                LOG_WARN("%.*s: %s", (int)name.size(), name.data(), e.what());
+            }
+        }
+
+        break;
+    }
+}
+
+} // namespace
+
+// TODO: 临时
+void eventloop(nvim::Nvim &nvim) {
+    using nvim::Object;
+    string expr = "( 3 + 2 ) * 4";
+    nvim::Object rv = nvim.eval(expr);
+    uint64_t res = rv.as_uint64_t();
+    LOG_DEBUG("nvim_eval('%s') = %llu (%s)", expr.c_str(), (unsigned long long)res, type_name(rv).c_str());
+
+    nvim::Array info = nvim.get_api_info();
+    int chan_id = info[0].as_uint64_t();
+    LOG_DEBUG("type(api-metadata): %s", type_name(info[1]).c_str());
+    LOG_INFO("Channel Id: %d", chan_id);
+
+    tree::App app(&nvim, chan_id);
+
+    string line = nvim.get_current_line();
+    LOG_DEBUG("get_current_line = %s", line.c_str());
+
+    LOG_INFO("eventloop started");
+    Lanes lanes;
+    while(true) {
+        // Trees whose scan finished meanwhile get their first paint.
+        app.poll();
+        msgpack::unpacked result;
+        // Sort everything read so far before picking the next message, a
+        // request jumps the notifications nothing handles.
+        while (nvim.client_.try_next_message(result)) {
+            lanes.push(std::move(result));
+        }
+        if (lanes.empty()) {
+            try {
+                // Also ends when a tree scan is done, poll() then picks it up.
+                result = nvim.client_.next_message(10);
+            }catch(boost::system::system_error& e) {
+                if (e.code() == boost::asio::error::timed_out) {
+                    app.idle();
+                    continue;
+                }
+                // nvim is gone (eof) or the connection broke, there is nothing
+                // left to serve.
+                LOG_INFO("eventloop stopped: %s", e.what());
+                const nvim::BufferPool::Stats &stats = nvim.client_.buffer_stats();
+                LOG_INFO("buffer pool: %llu hits, %llu misses (%.1f%%)",
+                         (unsigned long long)stats.hits, (unsigned long long)stats.misses,
+                         stats.hit_rate() * 100);
+                return;
+            }
+            lanes.push(std::move(result));
+            continue;
+        }
+
+        result = lanes.pop();
+        dispatch(nvim, app, result.get());
+    }
+}
+
+} // namespace tree
@@ -0,0 +1,12 @@
+#ifndef NVIM_CPP_EVENTLOOP
+#define NVIM_CPP_EVENTLOOP
+
+#include "nvim.hpp"
+
+namespace tree {
+
+/// Serve nvim on a connected client until the connection is closed.
+void eventloop(nvim::Nvim &nvim);
+
+} // namespace tree
+#endif
@@ -0,0 +1,279 @@
+#include "session.h"
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "log.hpp"
+
+#ifdef _WIN32
+#include <fstream>
+#include <process.h>
+#include <sstream>
+#include <thread>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using std::string;
+using std::vector;
+using boost::string_ref;
+
+namespace tree {
+
+namespace {
+
+// Native byte order and sizes: a snapshot is read back by the machine that
+// wrote it, anything else fails the header check and is ignored.
+const char kMagic[8] = {'T', 'R', 'E', 'E', 'S', 'N', 'A', 'P'};
+const uint32_t kVersion = 1;
+const uint32_t kByteOrder = 0x01020304;
+
+//  header   magic[8] u32 version, u32 byte order, u64 file size
+//  root     str
+//  expanded u32 n, str * n
+//  cursors  u32 n, (str path, i32 line) * n
+//  lines    u32 n, str * n
+//  dirs     u32 n, (str path, i64 mtime, u32 m, (u8 is_dir, str name) * m) * n
+//  str      u32 size, bytes
+class Writer {
+public:
+    template <typename T>
+    void put(T v) { buf_.append(reinterpret_cast<const char *>(&v), sizeof(v)); }
+    void put(string_ref s) {
+        put(static_cast<uint32_t>(s.size()));
+        buf_.append(s.data(), s.size());
+    }
+    string &buf() { return buf_; }
+
+private:
+    string buf_;
+};
+
+// Every read is bounds checked, a short or damaged file leaves ok() false.
+class Reader {
+public:
+    Reader(const char *data, size_t size) : p_(data), end_(data + size) {}
+
+    template <typename T>
+    T get() {
+        T v{};
+        if (!take(sizeof(v)))
+            return v;
+        std::memcpy(&v, p_ - sizeof(v), sizeof(v));
+        return v;
+    }
+    string_ref get_str() {
+        uint32_t n = get<uint32_t>();
+        if (!take(n))
+            return string_ref();
+        return string_ref(p_ - n, n);
+    }
+    // A count, refused when the rest of the file could not even hold that
+    // many items of min_size bytes.
+    uint32_t get_count(size_t min_size) {
+        uint32_t n = get<uint32_t>();
+        if (ok_ && n > static_cast<size_t>(end_ - p_) / min_size)
+            ok_ = false;
+        return ok_ ? n : 0;
+    }
+    bool ok() const { return ok_; }
+    bool at_end() const { return p_ == end_; }
+
+private:
+    bool take(size_t n) {
+        if (!ok_ || static_cast<size_t>(end_ - p_) < n) {
+            ok_ = false;
+            return false;
+        }
+        p_ += n;
+        return true;
+    }
+
+    const char *p_;
+    const char *end_;
+    bool ok_ = true;
+};
+
+} // namespace
+
+Snapshot::~Snapshot()
+{
+    if (!data_)
+        return;
+#ifdef _WIN32
+    delete[] data_;
+#else
+    munmap(const_cast<char *>(data_), size_);
+#endif
+}
+
+std::shared_ptr<const Snapshot> Snapshot::load(const string &file, const string &root)
+{
+    std::shared_ptr<Snapshot> snap(new Snapshot);
+#ifdef _WIN32
+    std::ifstream in(file, std::ios::binary | std::ios::ate);
+    if (!in)
+        return nullptr;
+    snap->size_ = static_cast<size_t>(in.tellg());
+    char *data = new char[snap->size_ ? snap->size_ : 1];
+    snap->data_ = data;
+    in.seekg(0);
+    if (!in.read(data, snap->size_))
+        return nullptr;
+#else
+    int fd = ::open(file.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return nullptr;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        ::close(fd);
+        return nullptr;
+    }
+    void *data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED)
+        return nullptr;
+    snap->data_ = static_cast<const char *>(data);
+    snap->size_ = st.st_size;
+#endif
+
+    if (!snap->parse()) {
+        LOG_WARN("%s: not a tree snapshot, or a damaged one", file.c_str());
+        return nullptr;
+    }
+    if (snap->root != root)
+        return nullptr;
+    LOG_DEBUG("%s: %zu lines, %zu directories", file.c_str(), snap->lines.size(), snap->dirs.size());
+    return snap;
+}
+
+bool Snapshot::parse()
+{
+    Reader r(data_, size_);
+    char magic[sizeof(kMagic)];
+    for (char &c : magic)
+        c = r.get<char>();
+    if (!r.ok() || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0)
+        return false;
+    if (r.get<uint32_t>() != kVersion || r.get<uint32_t>() != kByteOrder ||
+            r.get<uint64_t>() != size_)
+        return false;
+
+    root = r.get_str();
+    for (uint32_t n = r.get_count(4); n > 0; --n)
+        expanded.push_back(r.get_str());
+    for (uint32_t n = r.get_count(8); n > 0; --n) {
+        string_ref p = r.get_str();
+        cursors.emplace_back(p, r.get<int32_t>());
+    }
+    for (uint32_t n = r.get_count(4); n > 0; --n)
+        lines.push_back(r.get_str());
+    for (uint32_t n = r.get_count(16); n > 0; --n) {
+        Dir dir;
+        dir.path = r.get_str();
+        dir.mtime = static_cast<std::time_t>(r.get<int64_t>());
+        for (uint32_t m = r.get_count(5); m > 0; --m) {
+            bool is_dir = r.get<uint8_t>() != 0;
+            dir.entries.emplace_back(r.get_str(), is_dir);
+        }
+        dirs.push_back(std::move(dir));
+    }
+    return r.ok() && r.at_end();
+}
+
+bool Snapshot::save(const string &file, const string &root,
+                    const vector<string> &expanded,
+                    const std::unordered_map<string, int> &cursors,
+                    const vector<string> &lines)
+{
+    Writer w;
+    w.buf().append(kMagic, sizeof(kMagic));
+    w.put(kVersion);
+    w.put(kByteOrder);
+    const size_t size_at = w.buf().size();
+    w.put(uint64_t(0));  // patched below
+
+    w.put(string_ref(root));
+    w.put(static_cast<uint32_t>(expanded.size()));
+    for (const string &p : expanded)
+        w.put(string_ref(p));
+    w.put(static_cast<uint32_t>(cursors.size()));
+    for (const auto &c : cursors) {
+        w.put(string_ref(c.first));
+        w.put(static_cast<int32_t>(c.second));
+    }
+    w.put(static_cast<uint32_t>(lines.size()));
+    for (const string &l : lines)
+        w.put(string_ref(l));
+
+    vector<string> dirs(expanded);
+    dirs.push_back(root);
+    Writer listings;
+    uint32_t count = 0;
+    for (const string &dir : dirs) {
+        std::time_t mtime;
+        auto listing = dir_cache.find(dir, mtime);
+        if (!listing)
+            continue;
+        listings.put(string_ref(dir));
+        listings.put(static_cast<int64_t>(mtime));
+        listings.put(static_cast<uint32_t>(listing->size()));
+        for (const DirEntry &e : *listing) {
+            listings.put(static_cast<uint8_t>(e.is_dir));
+            listings.put(string_ref(e.p.filename().string()));
+        }
+        ++count;
+    }
+    w.put(count);
+    w.buf() += listings.buf();
+
+    const uint64_t size = w.buf().size();
+    std::memcpy(&w.buf()[size_at], &size, sizeof(size));
+
+    // Trees of several clients may save to the same file at once, each
+    // writes a temporary of its own.
+#ifdef _WIN32
+    std::ostringstream name;
+    name << file << '.' << _getpid() << '.' << std::this_thread::get_id() << ".tmp";
+    const string tmp = name.str();
+    FILE *f = std::fopen(tmp.c_str(), "wb");
+#else
+    string tmp = file + ".XXXXXX";
+    const int fd = mkstemp(&tmp[0]);
+    FILE *f = fd < 0 ? nullptr : fdopen(fd, "wb");
+    if (fd >= 0 && !f) {
+        ::close(fd);
+        ::unlink(tmp.c_str());
+    }
+#endif
+    if (!f) {
+        LOG_WARN("%s: %s", tmp.c_str(), std::strerror(errno));
+        return false;
+    }
+    bool ok = std::fwrite(w.buf().data(), 1, w.buf().size(), f) == w.buf().size();
+    ok = std::fclose(f) == 0 && ok;
+    if (!ok || std::rename(tmp.c_str(), file.c_str()) != 0) {
+        LOG_WARN("%s: %s", file.c_str(), std::strerror(errno));
+        std::remove(tmp.c_str());
+        return false;
+    }
+    return true;
+}
+
+void Snapshot::seed(DirCache &cache) const
+{
+    for (const Dir &dir : dirs) {
+        const boost::filesystem::path base(dir.path.to_string());
+        auto listing = std::make_shared<DirListing>();
+        listing->reserve(dir.entries.size());
+        for (const auto &e : dir.entries)
+            listing->push_back({base / e.first.to_string(), e.second});
+        cache.seed(base.string(), dir.mtime, std::move(listing));
+    }
+}
+
+} // namespace tree
@@ -0,0 +1,68 @@
+#ifndef NVIM_CPP_SESSION
+#define NVIM_CPP_SESSION
+
+#include <ctime>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <boost/utility/string_ref.hpp>
+#include "cache.h"
+
+namespace tree {
+
+/// A tree as it was last shown, kept in cfg.session_file: the opened
+/// directories with their listings, the cursor history and the rendered
+/// lines. A tree opened on the same root paints the lines at once, before
+/// anything is scanned, and the listings seed dir_cache so that the rescan
+/// reads only the directories changed since.
+///
+/// The file is mapped and read in place, every string_ref below points
+/// into the mapping and lives as long as the Snapshot.
+class Snapshot
+{
+public:
+    struct Dir {
+        boost::string_ref path;
+        std::time_t mtime;
+        // Names in the order of the listing, and whether each is a directory.
+        std::vector<std::pair<boost::string_ref, bool>> entries;
+    };
+
+    Snapshot(const Snapshot &) = delete;
+    Snapshot &operator=(const Snapshot &) = delete;
+    ~Snapshot();
+
+    /// nullptr when file is missing, damaged, of another format version or
+    /// of another root.
+    static std::shared_ptr<const Snapshot> load(const std::string &file, const std::string &root);
+
+    /// Write file through a temporary renamed over it. The listings of root
+    /// and of the expanded directories are taken from dir_cache, those not
+    /// in it are left out and listed again at load. false on failure.
+    static bool save(const std::string &file, const std::string &root,
+                     const std::vector<std::string> &expanded,
+                     const std::unordered_map<std::string, int> &cursors,
+                     const std::vector<std::string> &lines);
+
+    /// Hand the listings over to cache, where list() checks them against
+    /// the mtime of each directory.
+    void seed(DirCache &cache) const;
+
+    boost::string_ref root;
+    std::vector<boost::string_ref> expanded;
+    std::vector<std::pair<boost::string_ref, int>> cursors;
+    std::vector<boost::string_ref> lines;
+    std::vector<Dir> dirs;
+
+private:
+    Snapshot() = default;
+    bool parse();
+
+    const char *data_ = nullptr;
+    size_t size_ = 0;
+};
+
+} // namespace tree
+#endif
@@ -1,23 +1,27 @@
 #include <boost/filesystem.hpp>
+#include <algorithm>
 #include <cinttypes>
 #include <cwchar>
 #include <codecvt>
 #include <chrono>
+#include <iterator>
+#include <map>
 #include "tree.h"
-#include "strnatcmp.hpp"
+#include "cache.h"
+#include "session.h"
+#include "dispatch.hpp"
 
 #if defined(Q_OS_WIN)
 extern int mk_wcwidth(wchar_t ucs);
 #endif
 using namespace boost::filesystem;
 using std::string;
-using std::cout;
-using std::endl;
 
 namespace tree {
-Tree::ClipboardMode Tree::paste_mode;
-list<string> Tree::clipboard;
-nvim::Nvim *Tree::api;
+thread_local Tree::ClipboardMode Tree::paste_mode;
+thread_local list<string> Tree::clipboard;
+thread_local nvim::Nvim *Tree::api;
+thread_local nvim::MethodStats Tree::action_stats;
 
 int wchar_width(wchar_t ucs)
 {
@@ -31,16 +35,102 @@ Tree::~Tree()
 {
     erase_entrylist(0, m_fileitem.size());
 }
-Tree::Tree(int bufnr, int ns_id)
-    : bufnr(bufnr), icon_ns_id(ns_id)
+Tree::Tree(int bufnr, int ns_id, const string &bufname)
+    : bufnr(bufnr), icon_ns_id(ns_id), m_batch(api->batch())
 {
+    // On its own: nvim stops an nvim_call_atomic at its first failing call,
+    // and the name fails (E95) when a buffer of a previous server has it.
+    api->async_buf_set_name(bufnr, bufname);
+    // The rest goes out in the same nvim_call_atomic as the first paint.
+    m_batch.buf_set_option(bufnr, "ft", "tree");
+    m_batch.buf_set_option(bufnr, "modifiable", false);
+
+    m_batch.command("lua tree = require('tree')");
+    // b->buf_attach(bufnr, false, {});
+    m_batch.execute_lua("tree.buf_attach(...)", {bufnr});
+}
 
-    api->buf_set_option(bufnr, "ft", "tree");
-    api->buf_set_option(bufnr, "modifiable", false);
+void Tree::prefetch(const string &root, const Map &cfgmap, const Snapshot *snap)
+{
+    if (snap) {
+        snap->seed(dir_cache);
+        for (const Snapshot::Dir &dir : snap->dirs) {
+            try {
+                dir_cache.list(dir.path.to_string());
+            } catch (const std::exception &e) {
+                // Gone since, changeRoot() skips it as well.
+            }
+        }
+    }
+    // Errors are left to changeRoot(), which reports them.
+    try {
+        Config cfg(cfgmap);
+        if (find(cfg.columns.begin(), cfg.columns.end(), GIT) != cfg.columns.end())
+            FileItem::preload_gmap(root);
+        if (is_directory(root))
+            dir_cache.list(root);
+    } catch (const std::exception &e) {
+        LOG_DEBUG("prefetch %s: %s", root.c_str(), e.what());
+    }
+}
 
-    api->command("lua tree = require('tree')");
-    // b->buf_attach(bufnr, false, {});
-    api->execute_lua("tree.buf_attach(...)", {bufnr});
+void Tree::restore(const Snapshot &snap)
+{
+    for (boost::string_ref p : snap.expanded)
+        expandStore[p.to_string()] = true;
+    for (const auto &c : snap.cursors)
+        cursorHistory[c.first.to_string()] = c.second;
+
+    vector<string> lines;
+    lines.reserve(snap.lines.size());
+    for (boost::string_ref l : snap.lines)
+        lines.push_back(l.to_string());
+    // Nothing is in m_fileitem yet, the model comes with changeRoot().
+    m_batch.buf_set_option(bufnr, "modifiable", true);
+    m_batch.buf_set_lines(bufnr, 0, -1, true, lines);
+    m_batch.buf_set_option(bufnr, "modifiable", false);
+}
+
+void Tree::save_session(bool now)
+{
+    static const std::chrono::seconds kSaveDelay(2);
+
+    if (cfg.session_file.empty() || !m_dirty || m_fileitem.empty())
+        return;
+    if (!now && std::chrono::steady_clock::now() - m_flushed < kSaveDelay)
+        return;
+    m_dirty = false;
+
+    const string root = m_fileitem[0]->p.string();
+    vector<string> expanded;
+    for (const auto &i : expandStore) {
+        if (i.second && i.first != root)
+            expanded.push_back(i.first);
+    }
+    unordered_map<string, int> cursors(cursorHistory);
+    if (ctx.cursor > 0)
+        cursors[root] = ctx.cursor;
+    vector<string> lines;
+    lines.reserve(m_fileitem.size());
+    for (size_t i = 0; i < m_fileitem.size(); ++i)
+        lines.push_back(makeline(i));
+    Snapshot::save(cfg.session_file, root, expanded, cursors, lines);
+}
+
+void Tree::resume()
+{
+    m_batch.buf_set_option(bufnr, "buflisted", cfg.listed);
+    nvim::Dictionary tree_cfg{
+        {"winwidth", cfg.winwidth},
+        {"winheight", cfg.winheight},
+        {"split", cfg.split.c_str()},
+        {"new", cfg.new_},
+        {"toggle", cfg.toggle},
+        {"direction", cfg.direction.c_str()},
+        {"winrow", cfg.winrow},
+        {"wincol", cfg.wincol},
+    };
+    m_batch.execute_lua("tree.resume(...)", {bufnr, tree_cfg});
 }
 
 // Characters can be full-width or half-width (with invisible characters being 0-width).
@@ -109,7 +199,7 @@ string Tree::makeline(const int pos)
         line.append(string(len, ' '));
         start = cell.col_end;
     }
-    // INFO("pos:%d line:%s\n", pos, line.c_str());
+    // LOG_DEBUG("pos:%d line:%s\n", pos, line.c_str());
     return line;
 }
 #define TEST
@@ -118,11 +208,12 @@ void Tree::set_cursor()
 {
     string k = (*m_fileitem[0]).p.string();
     auto got = cursorHistory.find(k);
-    if (got != cursorHistory.end()) {
-        api->async_win_set_cursor(0, {cursorHistory[k], 0});
+    // A line that is gone would fail the rest of the batch.
+    if (got != cursorHistory.end() && got->second >= 1 && size_t(got->second) <= m_fileitem.size()) {
+        m_batch.win_set_cursor(0, {got->second, 0});
     }
 }
-void Tree::changeRoot(const string &root)
+void Tree::changeRoot(const string &root, const vector<boost::string_ref> *shown)
 {
 #ifdef TEST
     auto start_change_root=system_clock::now();
@@ -137,8 +228,9 @@ void Tree::changeRoot(const string &root)
 
     auto i = find(cfg.columns.begin(), cfg.columns.end(), GIT);
     if (i != cfg.columns.end()) {
-        FileItem::update_gmap(root);
+        FileItem::update_gmap(root, m_first_root);
     }
+    m_first_root = false;
     targets.clear();
     erase_entrylist(0, m_fileitem.size());
 
@@ -163,12 +255,27 @@ void Tree::changeRoot(const string &root)
 
     insert_entrylist(child_fileitem, 1, ret);
 
-    buf_set_lines(0, -1, true, ret);
+    if (shown) {
+        // Rows equal at both ends stay as painted.
+        const size_t n = std::min(ret.size(), shown->size());
+        size_t s = 0, e = 0;
+        while (s < n && ret[s] == (*shown)[s])
+            ++s;
+        while (e < n - s && ret[ret.size() - 1 - e] == (*shown)[shown->size() - 1 - e])
+            ++e;
+        if (s < ret.size() || ret.size() != shown->size())
+            buf_set_lines(s, shown->size() - e, true,
+                          vector<string>(ret.begin() + s, ret.end() - e));
+    }
+    else
+        buf_set_lines(0, -1, true, ret);
 
     hline(0, m_fileitem.size());
+    if (shown)
+        set_cursor();
 #ifdef TEST
     duration<double> time_change_root = system_clock::now()-start_change_root;
-    printf("change_root Elapsed time:%.9f secs.\n", time_change_root.count());
+    LOG_DEBUG("change_root Elapsed time:%.9f secs.", time_change_root.count());
 #endif
 }
 
@@ -313,11 +420,73 @@ std::tuple<int, int> Tree::find_range(int l)
     return std::make_tuple(s, i-1);
 }
 
-/// 0-based [sl, el).
+/// Send the buffer updates recorded since the last flush as
+/// nvim_call_atomic requests. Highlights go last, for the rows as they are
+/// now, in batches of kMaxBatchCalls so that the outgoing queue can push
+/// back between them.
+void Tree::flush()
+{
+    static const size_t kMaxBatchCalls = 4096;
+
+    const int rows = m_fileitem.size();
+    for (const auto &range : m_hl_pending) {
+        const int end = std::min(range.second, rows);
+        for (int i = range.first; i < end; ) {
+            int e = std::min(end, i + 256);
+            add_highlights(i, e);
+            i = e;
+            if (m_batch.size() >= kMaxBatchCalls)
+                m_batch.send();
+        }
+    }
+    m_hl_pending.clear();
+    m_batch.send();
+    m_dirty = true;
+    m_flushed = std::chrono::steady_clock::now();
+}
+
+/// Mark 0-based [sl, el) for highlighting, merged with the pending rows.
 void Tree::hline(int sl, int el)
+{
+    if (sl >= el)
+        return;
+    auto it = std::lower_bound(m_hl_pending.begin(), m_hl_pending.end(),
+            std::make_pair(sl, sl));
+    // The range just before may touch or overlap [sl, el) as well.
+    if (it != m_hl_pending.begin() && std::prev(it)->second >= sl)
+        --it;
+    auto last = it;
+    while (last != m_hl_pending.end() && last->first <= el) {
+        sl = std::min(sl, last->first);
+        el = std::max(el, last->second);
+        ++last;
+    }
+    it = m_hl_pending.erase(it, last);
+    m_hl_pending.insert(it, std::make_pair(sl, el));
+}
+
+/// Lines [s, e) were replaced by n lines (e == -1: up to the end): the
+/// pending rows in there are dropped, they are rewritten and highlighted
+/// again by the caller; the rows below move with the lines.
+void Tree::shift_highlights(int s, int e, int n)
+{
+    vector<std::pair<int, int>> shifted;
+    for (const auto &range : m_hl_pending) {
+        if (range.first < s)
+            shifted.emplace_back(range.first, std::min(range.second, s));
+        if (e >= 0 && range.second > e) {
+            int d = n - (e - s);
+            shifted.emplace_back(std::max(range.first, e) + d, range.second + d);
+        }
+    }
+    m_hl_pending.swap(shifted);
+}
+
+/// 0-based [sl, el).
+void Tree::add_highlights(int sl, int el)
 {
     int bufnr = this->bufnr;
-    api->async_buf_clear_namespace(bufnr, icon_ns_id, sl, el);
+    m_batch.buf_clear_namespace(bufnr, icon_ns_id, sl, el);
     for (int i = sl;i<el;++i)
     {
         const FileItem &fileitem = *m_fileitem[i];
@@ -328,17 +497,17 @@ void Tree::hline(int sl, int el)
 
             if(col==FILENAME) {
                 sprintf(name, "tree_%u_%u", col, is_directory(fileitem.p));
-                api->async_buf_add_highlight(bufnr, icon_ns_id, name, i, cell.byte_start, cell.byte_start+cell.text.size());
+                m_batch.buf_add_highlight(bufnr, icon_ns_id, name, i, cell.byte_start, cell.byte_start+cell.text.size());
             } else if(col==ICON || col==GIT || col==MARK) {
                 // :hi tree_<tab>
                 sprintf(name, "tree_%u_%u", col, cell.color);
                 // sprintf(name, "tree_%s", cell.text.data());
                 // auto req_hl = api->buf_add_highlight(bufnr, 0, "String", 0, 0, 3);
                 // call buf_add_highlight(0, -1, "Identifier", 0, 5, -1)
-                api->async_buf_add_highlight(bufnr, icon_ns_id, name, i, cell.byte_start, cell.byte_start+cell.text.size());
+                m_batch.buf_add_highlight(bufnr, icon_ns_id, name, i, cell.byte_start, cell.byte_start+cell.text.size());
             } else if (col==SIZE || col==TIME || col==INDENT){
                 sprintf(name, "tree_%u", col);
-                api->async_buf_add_highlight(bufnr, icon_ns_id, name, i, cell.byte_start, cell.byte_start+cell.text.size());
+                m_batch.buf_add_highlight(bufnr, icon_ns_id, name, i, cell.byte_start, cell.byte_start+cell.text.size());
             }
         }
     }
@@ -347,7 +516,7 @@ void Tree::hline(int sl, int el)
 /// 0-based [sl, el).
 void Tree::redraw_line(int sl, int el)
 {
-    INFO("(1-based): [%d, %d]\n", sl+1, el);
+    LOG_DEBUG("(1-based): [%d, %d]\n", sl+1, el);
 
     vector<string> ret;
     const int kStop = cfg.filename_colstop;
@@ -406,7 +575,7 @@ void Tree::redraw_recursively(int l)
     std::tuple<int, int> se = find_range(l);
     int s = std::get<0>(se) + 1;
     int e = std::get<1>(se) + 1;
-    INFO("redraw range(1-based): [%d, %d]\n", s+1, e);
+    LOG_DEBUG("redraw range(1-based): [%d, %d]\n", s+1, e);
 
     erase_entrylist(s, e);
 
@@ -445,33 +614,26 @@ void Tree::erase_entrylist(const int s, const int e)
 void Tree::entryInfoListRecursively(const FileItem& item,
                                    vector<FileItem*> &fileitem_lst)
 {
-    path dir(item.p);
     const int level = item.level+1;
-    typedef vector<path> vec;             // store paths,
-    vec v;                                // so we can sort them later
+    std::shared_ptr<const DirListing> listing;
     try {
-        if (cfg.show_ignored_files)
-            copy(directory_iterator(item.p), directory_iterator(), back_inserter(v));
-        else
-            copy_if(directory_iterator(item.p), directory_iterator(), back_inserter(v),
-                [](auto x){return (x.path().filename().string().front() != '.');});
+        listing = dir_cache.list(item.p);
     } catch(std::exception& e) {
-        INFO("-------> %s\n", e.what());
+        LOG_DEBUG("-------> %s\n", e.what());
         return;
     }
-    sort(v.begin(), v.end(), [](path x, path y) {
-        if (is_directory(x) == is_directory(y))
-            return compareNat(x.string(), y.string());
-        else
-            return is_directory(x) > is_directory(y);
-    });
+    vector<const DirEntry*> v;
+    for (const DirEntry &x : *listing) {
+        if (cfg.show_ignored_files || x.p.filename().string().front() != '.')
+            v.push_back(&x);
+    }
 
-    for (auto &x : v) {
+    for (const DirEntry *x : v) {
       try {
-        FileItem *fileitem = new FileItem(x);
+        FileItem *fileitem = new FileItem(x->p);
         fileitem->level = level;
         fileitem->parent = &item;
-        if (&x == &(*(v.end()-1))) {
+        if (x == v.back()) {
             fileitem->last = true;
         }
 
@@ -492,19 +654,16 @@ void Tree::entryInfoListRecursively(const FileItem& item,
 // shrink recursively
 void Tree::shrinkRecursively(const string &p)
 {
-    path dir(p);
-    // set_dir(dir);
-    typedef vector<path> vec;             // store paths,
-    vec v;                                // so we can sort them later
+    std::shared_ptr<const DirListing> listing;
     try {
-        copy(directory_iterator(p), directory_iterator(), back_inserter(v));
+        listing = dir_cache.list(p);
     } catch(std::exception& e) {
-        INFO("-------> %s\n", e.what());
+        LOG_DEBUG("-------> %s\n", e.what());
         return;
     }
 
-    for (auto x : v) {
-        string p = x.string();
+    for (const DirEntry &x : *listing) {
+        string p = x.p.string();
 
         auto got = expandStore.find(p);
         if (got != expandStore.end() && expandStore[p]) {
@@ -518,32 +677,25 @@ void Tree::shrinkRecursively(const string &p)
 void Tree::expandRecursively(const FileItem &item, vector<FileItem*> &fileitems)
 {
     const int level = item.level+1;
-    typedef vector<directory_entry> vec;             // store paths,
-    vec v;                                // so we can sort them later
+    std::shared_ptr<const DirListing> listing;
     try {
-        copy(directory_iterator(item.p), directory_iterator(), back_inserter(v));
+        listing = dir_cache.list(item.p);
     } catch(std::exception& e) {
-        INFO("-------> %s\n", e.what());
+        LOG_DEBUG("-------> %s\n", e.what());
         return;
     }
-    sort(v.begin(), v.end(), [](path x, path y) {
-        if (is_directory(x) == is_directory(y))
-            return compareNat(x.string(), y.string());
-        else
-            return is_directory(x) > is_directory(y);
-    });
 
-    for (directory_entry &x : v) {
+    for (const DirEntry &x : *listing) {
       try {
-        FileItem *fileitem = new FileItem(x);
+        FileItem *fileitem = new FileItem(x.p);
         fileitem->level = level;
         fileitem->parent = &item;
-        if (&x == &(*(v.end()-1))) {
+        if (&x == &listing->back()) {
             fileitem->last = true;
         }
 
-        if (is_directory(x)) {
-            string p = x.path().string();
+        if (x.is_dir) {
+            string p = x.p.string();
             expandStore[p] = true;
             fileitem->opened_tree = true;
             fileitems.push_back(fileitem);
@@ -559,7 +711,7 @@ void Tree::expandRecursively(const FileItem &item, vector<FileItem*> &fileitems)
 
 void Tree::handleRename(string &input)
 {
-    INFO("\n");
+    LOG_DEBUG("\n");
 
     Cell & cur = col_map[FILENAME][ctx.cursor-1];
     FileItem & item = *m_fileitem[ctx.cursor-1];
@@ -581,7 +733,7 @@ void Tree::handleRename(string &input)
     changeRoot(root.p.string());
 
     // api->execute_lua("tree.print_message(...)", {"Rename failed"});
-
+    flush();
 }
 void Tree::handleNewFile(const string &input)
 {
@@ -589,7 +741,7 @@ void Tree::handleNewFile(const string &input)
         api->async_execute_lua("tree.print_message(...)", {"Canceled"});
         return;
     }
-    INFO("input: %s\n", input.c_str());
+    LOG_DEBUG("input: %s\n", input.c_str());
 
     // Cell & cur = col_map["filename"][ctx.cursor-1];
     FileItem & item = *m_fileitem[ctx.cursor-1];
@@ -597,7 +749,7 @@ void Tree::handleNewFile(const string &input)
     path dest = item.opened_tree ? item.p : item.p.parent_path();
 
     dest /= input;
-    INFO("dest: %s\n", dest.string().c_str());
+    LOG_DEBUG("dest: %s\n", dest.string().c_str());
     // QFileInfo fi(dest.filePath(input));
     // NOTE: failed when same name file exists
     // TODO: No case sensitive on macos 10.14.5; Works on linux.
@@ -624,10 +776,11 @@ void Tree::handleNewFile(const string &input)
     // TODO: Find in subdirectories is faster
     for (int i = 0; i < m_fileitem.size(); i++) {
         if (m_fileitem[i]->p == dest) {
-            api->async_win_set_cursor(0, {i + 1, 0});
+            m_batch.win_set_cursor(0, {i + 1, 0});
             break;
         }
     }
+    flush();
 }
 
 /// 收集无序targets
@@ -646,7 +799,7 @@ void Tree::save_cursor()
 {
     FileItem &item = *m_fileitem[0];
     cursorHistory[item.p.string()] = ctx.cursor;
-    INFO("cursorHistory: %s -> %d\n", item.p.string().c_str(), ctx.cursor);
+    LOG_DEBUG("cursorHistory: %s -> %d\n", item.p.string().c_str(), ctx.cursor);
 }
 void Tree::paste(const int ln, const string &src, const string &dest)
 {
@@ -654,13 +807,13 @@ void Tree::paste(const int ln, const string &src, const string &dest)
         if (paste_mode == COPY) {
             copy(src, dest);
             api->async_execute_lua("tree.print_message(...)", {"Copyed"});
-            INFO("Copy Paste dir\n");
+            LOG_DEBUG("Copy Paste dir\n");
             int pidx = find_parent(ln);
             redraw_recursively(pidx);
         }
         else if (paste_mode == MOVE){
             boost::filesystem::rename(src, dest);
-            INFO("Move Paste dir\n");
+            LOG_DEBUG("Move Paste dir\n");
             FileItem &root = *m_fileitem[0];
             changeRoot(root.p.string());
         }
@@ -669,66 +822,52 @@ void Tree::paste(const int ln, const string &src, const string &dest)
         if (paste_mode == COPY) {
             copy(src, dest);
             api->async_execute_lua("tree.print_message(...)", {"Copyed"});
-            INFO("Copy Paste\n");
+            LOG_DEBUG("Copy Paste\n");
             int pidx = find_parent(ln);
             redraw_recursively(pidx);
         }
         else if (paste_mode == MOVE){
             boost::filesystem::rename(src, dest);
-            INFO("Move Paste\n");
+            LOG_DEBUG("Move Paste\n");
             FileItem &root = *m_fileitem[0];
             changeRoot(root.p.string());
         }
     }
+    flush();
     return;
 }
-typedef void (Tree::*Action)(const nvim::Array& args);
-std::unordered_map<string, Action> action_map {
-    {"cd"                   , &Tree::cd},
-    {"goto"                 , &Tree::goto_},
-    {"open_or_close_tree"   , &Tree::open_tree},
-    {"open"                 , &Tree::open},
-    {"copy"                 , &Tree::copy_},
-    {"move"                 , &Tree::move},
-    {"paste"                , &Tree::pre_paste},
-    {"remove"               , &Tree::pre_remove},
-    {"yank_path"            , &Tree::yank_path},
-    {"toggle_select"        , &Tree::toggle_select},
-    {"toggle_select_all"    , &Tree::toggle_select_all},
-    {"print"                , &Tree::print},
-    {"debug"                , &Tree::debug},
-    {"toggle_ignored_files" , &Tree::toggle_ignored_files},
-    {"redraw"               , &Tree::redraw},
-    {"new_file"             , &Tree::new_file},
-    {"execute_system"       , &Tree::execute_system},
-    {"rename"               , &Tree::rename},
-    {"drop"                 , &Tree::drop},
-    {"call"                 , &Tree::call},
-    {"view"                 , &Tree::view},
-    {"open_tree_recursive"  , &Tree::open_or_close_tree_recursively},
-};
-void Tree::action(const string &action, const nvim::Array &args,
-                  const Map &context)
+typedef void (Tree::*Action)(const nvim::ObjectRef& args);
+// Indexed by rpc::Action, names and members are listed in tree_rpc.json.
+#define TREE_ACTION_MEMBER(id, member) &Tree::member,
+static const Action action_table[] = { TREE_ACTIONS(TREE_ACTION_MEMBER) };
+#undef TREE_ACTION_MEMBER
+static_assert(sizeof(action_table) / sizeof(action_table[0]) == size_t(rpc::Action::kUnknown),
+              "one member per action");
+void Tree::action(boost::string_ref action, const nvim::ObjectRef &args,
+                  const Context &context)
 {
-    INFO("action: %s\n", action.c_str());
+    LOG_DEBUG("action: %.*s\n", (int)action.size(), action.data());
+    // Up to the end of flush(), which sends what the action changed.
+    nvim::ScopedStats record(action_stats, action, api->client_.bytes_sent());
 
     this->ctx = context;
-    INFO("cursor position(1-based): %d\n", ctx.cursor);
+    LOG_DEBUG("cursor position(1-based): %d\n", ctx.cursor);
 
-    auto search = action_map.find(action);
-    if (search != action_map.end()) {
-        (this->*action_map[action])(args);
+    rpc::Action id = rpc::find_action(action);
+    if (id != rpc::Action::kUnknown) {
+        (this->*action_table[size_t(id)])(args);
     }
     else {
-        api->call_function("tree#util#print_message", {"Unknown Action: " + action});
+        api->async_call_function("tree#util#print_message", {"Unknown Action: " + action.to_string()});
     }
+    flush();
 }
 
 /// l is 0-based row number.
-void Tree::open_tree(const nvim::Array &args)
+void Tree::open_tree(const nvim::ObjectRef &args)
 {
     const int l = ctx.cursor - 1;
-    INFO("\n");
+    LOG_DEBUG("\n");
     assert(0 <= l && l < m_fileitem.size());
     // if (l == 0) return;
     vector<string> ret;
@@ -765,7 +904,7 @@ void Tree::open_tree(const nvim::Array &args)
         std::tuple<int, int> se = find_range(l);
         int s = std::get<0>(se) + 1;
         int e = std::get<1>(se) + 1;
-        printf("\tclose range(1-based): [%d, %d]\n", s+1, e);
+        LOG_DEBUG("close range(1-based): [%d, %d]", s+1, e);
         buf_set_lines(s, e, true, {});
 
         erase_entrylist(s, e);
@@ -778,11 +917,11 @@ void Tree::open_tree(const nvim::Array &args)
         int s = std::get<0>(se) + 1;
         int e = std::get<1>(se) + 1;
 
-        printf("\tclose range(1-based): [%d, %d]\n", s+1, e);
+        LOG_DEBUG("close range(1-based): [%d, %d]", s+1, e);
 
         buf_set_lines(s, e, true, {});
         // ref to https://github.com/equalsraf/neovim-qt/issues/596
-        api->async_win_set_cursor(0, {s, 0});
+        m_batch.win_set_cursor(0, {s, 0});
         erase_entrylist(s, e);
 
         FileItem &father = *m_fileitem[parent];
@@ -809,7 +948,7 @@ Map Tree::get_candidate(const int pos)
         {"is_selected", item.selected}
     };
 }
-void Tree::open(const nvim::Array &args)
+void Tree::open(const nvim::ObjectRef &args)
 {
     save_cursor();
     const int l = ctx.cursor - 1;
@@ -817,8 +956,8 @@ void Tree::open(const nvim::Array &args)
     if (is_directory(p)) {
         changeRoot(p.string());
     }
-    else if (args.size()>0 && args[0].as_string()=="vsplit") {
-        INFO("vsplit: %s\n", p.string().c_str());
+    else if (args.size()>0 && args.at(0).as_string_ref()=="vsplit") {
+        LOG_DEBUG("vsplit: %s\n", p.string().c_str());
         api->async_call_function("tree#util#execute_path", {"rightbelow vsplit", p.string()});
     }
     else {
@@ -826,7 +965,7 @@ void Tree::open(const nvim::Array &args)
     }
 }
 
-void Tree::rename(const nvim::Array &args)
+void Tree::rename(const nvim::ObjectRef &args)
 {
     FileItem &cur = *m_fileitem[ctx.cursor - 1];
     string info = cur.p.string();
@@ -840,18 +979,20 @@ void Tree::rename(const nvim::Array &args)
     api->async_execute_lua("tree.rename(...)", {cfg});
 }
 
-void Tree::drop(const nvim::Array &args)
+void Tree::drop(const nvim::ObjectRef &args)
 {
     FileItem &cur = *m_fileitem[ctx.cursor - 1];
     const auto p = cur.p;
     if (is_directory(cur.p))
         changeRoot(p.string());
     else {
-        api->async_execute_lua("tree.drop(...)", {args, p.string()});
+        nvim::Object drop_args;
+        args.convert(drop_args);
+        api->async_execute_lua("tree.drop(...)", {drop_args, p.string()});
     }
 }
 // TODO Handle calls without viewing permission
-void Tree::cd(const nvim::Array &args)
+void Tree::cd(const nvim::ObjectRef &args)
 {
     save_cursor();
     if (args.size()>0) {
@@ -859,7 +1000,7 @@ void Tree::cd(const nvim::Array &args)
 
         if (dir=="..") {
             path & curdir = m_fileitem[0]->p;
-            INFO("cd %s\n", curdir.parent_path().string().c_str());
+            LOG_DEBUG("cd %s\n", curdir.parent_path().string().c_str());
             changeRoot(curdir.parent_path().string());
         }
         else if (dir == ".") {
@@ -878,7 +1019,7 @@ void Tree::cd(const nvim::Array &args)
         // changeRoot(QDir::home().absolutePath());
     }
 }
-void Tree::call(const nvim::Array &args)
+void Tree::call(const nvim::ObjectRef &args)
 {
     string func = args.at(0).as_string();
     FileItem &cur = *m_fileitem[ctx.cursor - 1];
@@ -888,7 +1029,7 @@ void Tree::call(const nvim::Array &args)
     api->async_call_function(func, {ctx});
 }
 
-void Tree::print(const nvim::Array &args)
+void Tree::print(const nvim::ObjectRef &args)
 {
     FileItem &cur = *m_fileitem[ctx.cursor - 1];
     string msg = cur.p.string();
@@ -896,7 +1037,7 @@ void Tree::print(const nvim::Array &args)
     string msg3 = "level=" + std::to_string(cur.level);
     api->async_execute_lua("tree.print_message(...)", {msg+" "+msg2+" "+msg3});
 }
-void Tree::pre_paste(const nvim::Array &args)
+void Tree::pre_paste(const nvim::ObjectRef &args)
 {
     if (clipboard.size() <= 0) {
         api->async_execute_lua("tree.print_message(...)", {"Nothing in clipboard"});
@@ -911,8 +1052,8 @@ void Tree::pre_paste(const nvim::Array &args)
         path curdir = cur.p.parent_path();
         if (cur.opened_tree) curdir = cur.p.string();
         string destfile = (curdir/=fname).string();
-        INFO("destfile: %s\n", destfile.c_str());
-        INFO("fname: %s\n", fname.c_str());
+        LOG_DEBUG("destfile: %s\n", destfile.c_str());
+        LOG_DEBUG("fname: %s\n", fname.c_str());
         if (exists(destfile)) {
             // api->async_execute_lua("tree.print_message(...)", {"Destination file exists"});
 
@@ -936,21 +1077,24 @@ void Tree::pre_paste(const nvim::Array &args)
     }
 }
 
-void Tree::debug(const nvim::Array &args)
+void Tree::debug(const nvim::ObjectRef &args)
 {
+    string columns;
     for (auto i : cfg.columns) {
-        cout << i << ":";
+        columns += std::to_string(i) + ":";
     }
-    cout << endl;
+    LOG_INFO("columns %s", columns.c_str());
     for (auto i : expandStore) {
-        cout << i.first << ":" << i.second << endl;
+        LOG_INFO("expanded %s:%d", i.first.c_str(), i.second);
     }
-    for (auto i : FileItem::git_map) {
-        cout << i.first << ":" << i.second << endl;
+    if (FileItem::git_map) {
+        for (auto i : *FileItem::git_map) {
+            LOG_INFO("git %s:%d", i.first.c_str(), i.second);
+        }
     }
     FileItem &cur = *m_fileitem[ctx.cursor - 1];
 }
-void Tree::yank_path(const nvim::Array &args)
+void Tree::yank_path(const nvim::ObjectRef &args)
 {
     vector<string> yank;
     for (const int &pos : targets) {
@@ -970,7 +1114,7 @@ void Tree::yank_path(const nvim::Array &args)
     reg.insert(0, "yank_path\n");
     api->async_execute_lua("tree.print_message(...)", {reg});
 }
-void Tree::pre_remove(const nvim::Array &args)
+void Tree::pre_remove(const nvim::ObjectRef &args)
 {
     int cnt = targets.size();
     Map farg;
@@ -990,7 +1134,7 @@ void Tree::remove()
         rmfiles.push_back(cur.p.string());
     }
     for (const string &f : rmfiles) {
-        cout << f << endl;
+        LOG_DEBUG("remove %s", f.c_str());
         if (is_directory(f))
             boost::filesystem::remove_all(f);
         else
@@ -999,13 +1143,14 @@ void Tree::remove()
     FileItem &root = *m_fileitem[0];
     changeRoot(root.p.string());
     set_cursor();
+    flush();
 }
-void Tree::redraw(const nvim::Array &args)
+void Tree::redraw(const nvim::ObjectRef &args)
 {
     FileItem &root = *m_fileitem[0];
     changeRoot(root.p.string());
 }
-void Tree::new_file(const nvim::Array &args)
+void Tree::new_file(const nvim::ObjectRef &args)
 {
     FileItem &cur = *m_fileitem[ctx.cursor - 1];
     string info;
@@ -1044,18 +1189,18 @@ void Tree::_toggle_select(const int pos)
 
     redraw_line(pos, pos+1);
 }
-void Tree::toggle_select(const nvim::Array &args)
+void Tree::toggle_select(const nvim::ObjectRef &args)
 {
     const int pos = ctx.cursor - 1;
     _toggle_select(pos);
 }
-void Tree::toggle_select_all(const nvim::Array &args)
+void Tree::toggle_select_all(const nvim::ObjectRef &args)
 {
     for (int i=1;i<m_fileitem.size();++i) {
         _toggle_select(i);
     }
 }
-void Tree::_copy_or_move(const nvim::Array &args)
+void Tree::_copy_or_move(const nvim::ObjectRef &args)
 {
     Tree::clipboard.clear();
 
@@ -1070,25 +1215,25 @@ void Tree::_copy_or_move(const nvim::Array &args)
         Tree::clipboard.push_back(cur.p.string());
     }
     for (auto i:clipboard)
-        cout << i << endl;
+        LOG_DEBUG("clipboard %s", i.c_str());
 }
 
-void Tree::copy_(const nvim::Array &args)
+void Tree::copy_(const nvim::ObjectRef &args)
 {
     paste_mode = COPY;
     _copy_or_move(args);
     api->async_execute_lua("tree.print_message(...)", {"Copy to clipboard"});
 }
-void Tree::move(const nvim::Array &args)
+void Tree::move(const nvim::ObjectRef &args)
 {
     paste_mode = MOVE;
     _copy_or_move(args);
     api->async_execute_lua("tree.print_message(...)", {"Move to clipboard"});
 }
-void Tree::open_or_close_tree_recursively(const nvim::Array &args)
+void Tree::open_or_close_tree_recursively(const nvim::ObjectRef &args)
 {
     const int l = ctx.cursor - 1;
-    INFO("\n");
+    LOG_DEBUG("\n");
     assert(0 <= l && l < m_fileitem.size());
     if (l == 0) return;
     vector<string> ret;
@@ -1123,7 +1268,7 @@ void Tree::open_or_close_tree_recursively(const nvim::Array &args)
         std::tuple<int, int> se = find_range(l);
         int s = std::get<0>(se) + 1;
         int e = std::get<1>(se) + 1;
-        printf("\tclose range(1-based): [%d, %d]\n", s+1, e);
+        LOG_DEBUG("close range(1-based): [%d, %d]", s+1, e);
         buf_set_lines(s, e, true, {});
         shrinkRecursively(p);
         erase_entrylist(s, e);
@@ -1137,11 +1282,11 @@ void Tree::open_or_close_tree_recursively(const nvim::Array &args)
         int s = std::get<0>(se) + 1;
         int e = std::get<1>(se) + 1;
 
-        printf("\tclose range(1-based): [%d, %d]\n", s+1, e);
+        LOG_DEBUG("close range(1-based): [%d, %d]", s+1, e);
 
         buf_set_lines(s, e, true, {});
         // ref to https://github.com/equalsraf/neovim-qt/issues/596
-        api->async_win_set_cursor(0, {s, 0});
+        m_batch.win_set_cursor(0, {s, 0});
 
         FileItem &father = *m_fileitem[parent];
         father.opened_tree = false;
@@ -1158,7 +1303,7 @@ void Tree::open_or_close_tree_recursively(const nvim::Array &args)
 
     return;
 }
-void Tree::goto_(const nvim::Array &args)
+void Tree::goto_(const nvim::ObjectRef &args)
 {
     const int l = ctx.cursor - 1;
 
@@ -1167,26 +1312,26 @@ void Tree::goto_(const nvim::Array &args)
 
         if (dest=="parent") {
             int p = find_parent(l);
-            api->async_win_set_cursor(0, {p+1, 0});
+            m_batch.win_set_cursor(0, {p+1, 0});
         }
     }
     else {
     }
 }
-void Tree::execute_system(const nvim::Array &args)
+void Tree::execute_system(const nvim::ObjectRef &args)
 {
     FileItem &cur = *m_fileitem[ctx.cursor - 1];
     string info = cur.p.string();
     api->async_execute_lua("tree.open(...)", {info});
 }
-void Tree::toggle_ignored_files(const nvim::Array &args)
+void Tree::toggle_ignored_files(const nvim::ObjectRef &args)
 {
     cfg.show_ignored_files = !cfg.show_ignored_files;
     FileItem &root = *m_fileitem[0];
     changeRoot(root.p.string());
 }
 // TODO Custom display content
-void Tree::view(const nvim::Array &args)
+void Tree::view(const nvim::ObjectRef &args)
 {
     FileItem &cur = *m_fileitem[ctx.cursor - 1];
     Cell time_cell(cfg, cur, TIME);
@@ -1198,7 +1343,7 @@ void Tree::view(const nvim::Array &args)
         {"date", time_cell.text},
         {"size", size},
     };
-    api->command("lua require('tree/float')");
-    api->execute_lua("Tree_display(...)", {info});
+    api->async_command("lua require('tree/float')");
+    api->async_execute_lua("Tree_display(...)", {info});
 }
 } // namespace tree
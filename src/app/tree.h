@@ -1,39 +1,41 @@
 #ifndef NVIM_CPP_TREE
 #define NVIM_CPP_TREE
 
+#include <chrono>
 #include <list>
 #include <tuple>
 #include <unordered_map>
 #include <boost/filesystem.hpp>
 #include "column.h"
+#include "log.hpp"
 #include "nvim.hpp"
 
-#ifdef NDEBUG
-#define INFO(...)
-#else
-#define INFO(...) \
-do{ \
-    fprintf(stdout, "[INFO]%s %s(Line %d): ",__FILE__,__FUNCTION__,__LINE__); \
-    fprintf(stdout, __VA_ARGS__); \
-}while(0)
-#endif
-
 using std::list;
 using std::string;
 using std::vector;
 using std::unordered_map;
 namespace tree {
+class Snapshot;
 // TODO using Hash = std::unordered_map<class _Key, class _Tp>;
 class Tree
 {
 public:
     Tree() = delete; // delete default constructor
     ~Tree();
-    Tree(int bufnr, int icon_ns_id);
+    // The nvim side setup of bufnr is recorded, sent by the first flush().
+    Tree(int bufnr, int icon_ns_id, const string &bufname);
+    // Warm dir_cache and git_cache for root on the calling thread, so that
+    // changeRoot() of a tree being created finds them ready.
+    // With snap, its listings are seeded first and checked against the
+    // mtime of each directory, the changed ones are read again.
+    static void prefetch(const string &root, const Map &cfgmap, const Snapshot *snap);
     enum ClipboardMode {COPY, MOVE};
-    static ClipboardMode paste_mode;
-    static list<string> clipboard;
-	static nvim::Nvim *api;
+    // Per client: a daemon serves each nvim on a thread of its own.
+    static thread_local ClipboardMode paste_mode;
+    static thread_local list<string> clipboard;
+	static thread_local nvim::Nvim *api;
+    // Calls, bytes sent and time per action, shared by the client's trees.
+    static thread_local nvim::MethodStats action_stats;
     int bufnr = -1;
     int icon_ns_id = -1;
     Config cfg;
@@ -42,55 +44,80 @@ public:
 
     void handleNewFile(const string &input);
     void handleRename(string &input);
-    void toggle_select(const nvim::Array &args);
-    void toggle_select_all(const nvim::Array &args);
-    void execute_system(const nvim::Array &args);
+    void toggle_select(const nvim::ObjectRef &args);
+    void toggle_select_all(const nvim::ObjectRef &args);
+    void execute_system(const nvim::ObjectRef &args);
     void redraw_line(int sl, int el);
-    void changeRoot(const string &path);
-    void action(const string &action, const nvim::Array &args, const Map &context);
+    // shown: the lines already in the buffer, painted by restore(). Only
+    // the rows that differ are sent then, and the cursor is put back.
+    void changeRoot(const string &path, const vector<boost::string_ref> *shown = nullptr);
+    // Paint the lines of snap before anything is scanned, and take over its
+    // opened directories and cursor history.
+    void restore(const Snapshot &snap);
+    // Write cfg.session_file if the tree changed since it was last written,
+    // once it has been left alone for a while unless now is set.
+    void save_session(bool now);
+    // Record the opening of the tree window, sent by the next flush().
+    void resume();
+    void action(boost::string_ref action, const nvim::ObjectRef &args, const Context &context);
 
     void remove();
-    void move(const nvim::Array &args);
+    void move(const nvim::ObjectRef &args);
     Map get_candidate(const int pos);
-    void new_file(const nvim::Array &args);
-    void redraw(const nvim::Array &args);
+    void new_file(const nvim::ObjectRef &args);
+    void redraw(const nvim::ObjectRef &args);
     void redraw_recursively(int l);
-    void yank_path(const nvim::Array &args);
-    void pre_remove(const nvim::Array &args);
-    void print(const nvim::Array &args);
-    void debug(const nvim::Array &args);
-    void open_tree(const nvim::Array &args);
-    void open_or_close_tree_recursively(const nvim::Array &args);
-    void open(const nvim::Array &args);
-    void drop(const nvim::Array &args);
-    void call(const nvim::Array &args);
-    void copy_(const nvim::Array &args);
-    void _copy_or_move(const nvim::Array &args);
-    void rename(const nvim::Array &args);
+    void yank_path(const nvim::ObjectRef &args);
+    void pre_remove(const nvim::ObjectRef &args);
+    void print(const nvim::ObjectRef &args);
+    void debug(const nvim::ObjectRef &args);
+    void open_tree(const nvim::ObjectRef &args);
+    void open_or_close_tree_recursively(const nvim::ObjectRef &args);
+    void open(const nvim::ObjectRef &args);
+    void drop(const nvim::ObjectRef &args);
+    void call(const nvim::ObjectRef &args);
+    void copy_(const nvim::ObjectRef &args);
+    void _copy_or_move(const nvim::ObjectRef &args);
+    void rename(const nvim::ObjectRef &args);
     void expandRecursively(const FileItem &item, vector<FileItem*> &fileitem_lst);
-    void cd(const nvim::Array &args);
-    void goto_(const nvim::Array &args);
-    void toggle_ignored_files(const nvim::Array &args);
+    void cd(const nvim::ObjectRef &args);
+    void goto_(const nvim::ObjectRef &args);
+    void toggle_ignored_files(const nvim::ObjectRef &args);
     void paste(const int ln, const string &src, const string &dest);
-    void pre_paste(const nvim::Array &args);
-    void view(const nvim::Array &args);
+    void pre_paste(const nvim::ObjectRef &args);
+    void view(const nvim::ObjectRef &args);
 
+    void flush();
     inline void buf_set_lines(int s, int e, bool strict, const vector<string> &replacement)
     {
-        api->async_buf_set_option(bufnr, "modifiable", true);
-        api->async_buf_set_lines(bufnr, s, e, strict, replacement);
-        api->async_buf_set_option(bufnr, "modifiable", false);
+        m_batch.buf_set_option(bufnr, "modifiable", true);
+        m_batch.buf_set_lines(bufnr, s, e, strict, replacement);
+        m_batch.buf_set_option(bufnr, "modifiable", false);
+        shift_highlights(s, e, replacement.size());
         // TODO: Fine-grained targets update
         collect_targets();
     };
 
 private:
+    // Rendering (lines, highlights, cursor) is recorded here and sent as
+    // one nvim_call_atomic by flush().
+    nvim::Nvim::Batch m_batch;
+    // Rows to highlight at the next flush(), sorted disjoint 0-based [s, e).
+    // Rows rewritten again before the flush are highlighted once.
+    vector<std::pair<int, int>> m_hl_pending;
+    // The next changeRoot() is the first one, right after prefetch().
+    bool m_first_root = true;
+    // Changed since the last save_session(), and last flushed at.
+    bool m_dirty = false;
+    std::chrono::steady_clock::time_point m_flushed;
     vector<FileItem *> m_fileitem;
     unordered_map<int, vector<Cell>> col_map;
     unordered_map<string, bool> expandStore;
     unordered_map<string, int> cursorHistory;
     list<int> targets;
     void hline(int sl, int el);
+    void shift_highlights(int s, int e, int n);
+    void add_highlights(int sl, int el);
     int find_parent(int l);
     std::tuple<int, int> find_range(int l);
     void set_cursor();
@@ -440,6 +440,27 @@ end
 -------------------- start of init.vim --------------------
 -- cant work in lua script
 -- print(vim.fn.expand('<sfile>'))
+-- Share one server between every nvim: connect to the daemon listening on
+-- path, and start it when nobody answers yet.
+local function connect_daemon(path)
+  local ok, chan = pcall(fn.sockconnect, 'pipe', path, {rpc = true})
+  if not ok or chan <= 0 then
+    fn.jobstart({project_root .. '/bin/tree', '--daemon', path}, {detach = true})
+    local i = 0
+    repeat
+      C('sleep 4m')
+      ok, chan = pcall(fn.sockconnect, 'pipe', path, {rpc = true})
+      i = i + 1
+    until (ok and chan > 0) or i >= 250
+  end
+  if not ok or chan <= 0 then
+    M.error('failed to connect to ' .. path)
+    return false
+  end
+  vim.g['tree#_channel_id'] = chan
+  return true
+end
+
 local function init_channel()
   if fn.has('nvim-0.5') == 0 then
     print('tree requires nvim 0.5+.')
@@ -449,12 +470,22 @@ local function init_channel()
   local servername = vim.v.servername
   local cmd
   -- NOTE: ~ cant expand in {cmd} arg of jobstart
-  if M.linux() then
-    cmd = {project_root .. '/bin/tree', servername}
+  local daemon = vim.g['tree#daemon']
+  if (M.linux() or M.macos()) and daemon ~= nil and daemon ~= '' then
+    return connect_daemon(fn.expand(daemon))
+  elseif M.linux() or M.macos() then
+    -- The server talks msgpack-rpc over its stdin/stdout, the channel is
+    -- usable as soon as jobstart returns.
+    cmd = {project_root .. '/bin/tree', '--stdio'}
+    local chan = fn.jobstart(cmd, {rpc = true})
+    if chan <= 0 then
+      M.error('failed to start ' .. cmd[1])
+      return false
+    end
+    vim.g['tree#_channel_id'] = chan
+    return true
   elseif M.windows() then
     cmd = {project_root .. '\\bin\\tree-nvim.exe', '--server', servername}
-  elseif M.macos() then
-    cmd = {project_root .. '/bin/tree', servername}
   end
   -- print('bin:', bin)
   -- print('servername:', servername)
@@ -557,9 +588,14 @@ local function init_context(user_context)
   return context
 end
 
+-- Sent with every action, so kept small: a server that set
+-- g:tree#_context_version takes the fields of internal_options() by
+-- position, [cursor, prev_bufnr, prev_winid, visual_start, visual_end].
 local function action_context()
-  local context = internal_options()
-  return context
+  if vim.g['tree#_context_version'] == 1 then
+    return {fn.line('.'), fn.bufnr('%'), fn.win_getid(), fn.line("'<"), fn.line("'>")}
+  end
+  return internal_options()
 end
 
 -------------------- end of init.vim --------------------
@@ -666,7 +702,7 @@ function M.get_candidate()
     return {}
   end
 
-  local context = internal_options()
+  local context = action_context()
   return rpcrequest('_tree_get_candidate', {context}, false)
 end
 function M.is_directory()
@@ -683,6 +719,17 @@ function M.get_context()
 
   return rpcrequest('_tree_get_context', {}, false)
 end
+
+-- Calls, bytes and latency of the server, per nvim API method, inbound
+-- request and action: `:lua print(vim.inspect(tree.stats()))`
+function M.stats()
+  return rpcrequest('_tree_stats', {}, false)
+end
+
+-- 'debug', 'info', 'warn', 'error' or 'off'
+function M.set_log_level(level)
+  return rpcrequest('_tree_log_level', {level}, false)
+end
 -------------------- end of tree.vim --------------------
 
 function M.rrequire(module)
@@ -0,0 +1,154 @@
+// tree-bench DIR [ROUNDS]
+//
+// Runs the server against MockNvim, no nvim needed: opens DIR, then for
+// ROUNDS rounds expands every top-level directory recursively, redraws and
+// collapses them again. Actions go through _tree_do_action, so each one is
+// timed from the request until the server answered, by which time the
+// mock has applied everything the action sent.
+#include "nvim.hpp"
+#include "app/eventloop.h"
+#include "mock_nvim.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <locale>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+using std::cerr;
+using std::endl;
+using std::string;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Bench {
+    nvim::MockNvim &mock;
+    int64_t bufnr;
+    nvim::MethodStats actions;
+
+    // Compact form: [cursor, prev_bufnr, prev_winid, visual_start, visual_end]
+    nvim::Array context(int64_t line) const {
+        return nvim::Array{line, bufnr, 1000, line, line};
+    }
+
+    bool is_directory(int64_t line) {
+        // _tree_get_candidate [context]
+        msgpack::unpacked res = mock.request("_tree_get_candidate",
+                nvim::Array{context(line)});
+        nvim::ObjectRef candidate = nvim::ObjectRef(res.get()).at(3);
+        return candidate.is_map() && candidate.get("is_directory").as_bool();
+    }
+
+    void action(const string &name, int64_t line) {
+        auto start = Clock::now();
+        // _tree_do_action [action, args, context]
+        mock.request("_tree_do_action", nvim::Array{name, nvim::Array{}, context(line)});
+        nvim::MethodStats::Entry &e = actions.entry(name);
+        e.add_bytes(0);
+        e.add_latency(Clock::now() - start);
+    }
+};
+
+void print_methods(const char *title, const nvim::MethodStats &stats, bool timed)
+{
+    printf("\n%-28s %8s %10s %10s %10s %12s\n", title, "count",
+           timed ? "avg_us" : "", timed ? "p99_us" : "", timed ? "max_us" : "", "bytes");
+    for (const auto &item : stats.entries()) {
+        const nvim::MethodStats::Entry &e = item.second;
+        if (timed) {
+            printf("%-28s %8llu %10llu %10llu %10llu %12llu\n", item.first.c_str(),
+                   (unsigned long long)e.count,
+                   (unsigned long long)(e.timed ? e.total_us / e.timed : 0),
+                   (unsigned long long)e.percentile_us(0.99),
+                   (unsigned long long)e.max_us, (unsigned long long)e.bytes);
+        } else {
+            printf("%-28s %8llu %10s %10s %10s %12llu\n", item.first.c_str(),
+                   (unsigned long long)e.count, "", "", "", (unsigned long long)e.bytes);
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2) {
+        cerr << "usage: " << argv[0] << " DIR [ROUNDS]" << endl;
+        return 2;
+    }
+    std::locale::global(std::locale(""));
+    string dir = argv[1];
+    int rounds = argc > 2 ? std::atoi(argv[2]) : 10;
+
+    string path = "/tmp/tree-bench-" + std::to_string(getpid()) + ".sock";
+    nvim::MockNvim mock(path);
+    std::thread server([&path] {
+        nvim::Nvim nvim;
+        nvim.connect_pipe(path);
+        tree::eventloop(nvim);
+    });
+    mock.accept();
+
+    // First paint: from _tree_start until the mock has the lines.
+    auto start = Clock::now();
+    mock.request("_tree_start", nvim::Array{nvim::Array{dir}, nvim::Dictionary{}});
+    bool painted = mock.wait([](const nvim::MockNvim::State &s) {
+        auto it = s.buffers.find(s.last_created);
+        return it != s.buffers.end() && !it->second.lines[0].empty();
+    }, 60);
+    double first_paint = std::chrono::duration<double>(Clock::now() - start).count();
+    if (!painted) {
+        cerr << "the server did not draw " << dir << endl;
+        mock.close();
+        server.join();
+        return 1;
+    }
+
+    nvim::MockNvim::State s = mock.state();
+    Bench bench{mock, s.last_created, {}};
+    // Line 1 is the root, cursor lines are 1-based.
+    std::vector<int64_t> dirs;
+    int64_t lines = s.buffers[s.last_created].lines.size();
+    for (int64_t line = 2; line <= lines; ++line) {
+        if (bench.is_directory(line))
+            dirs.push_back(line);
+    }
+
+    start = Clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        // Bottom up, expanding a directory leaves the lines above alone.
+        for (auto it = dirs.rbegin(); it != dirs.rend(); ++it)
+            bench.action("open_tree_recursive", *it);
+        bench.action("redraw", 1);
+        // Top down, each collapse brings the next directory back to its line.
+        for (int64_t line : dirs)
+            bench.action("open_tree_recursive", line);
+    }
+    double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+    s = mock.state();
+    const nvim::MockNvim::Buffer &b = s.buffers[s.last_created];
+    const nvim::MockNvim::Work &w = s.work;
+    printf("\n%s: %lld lines, %zu top-level directories\n", dir.c_str(), (long long)lines, dirs.size());
+    printf("first paint: %.2f ms\n", first_paint * 1000);
+    printf("%d rounds: %.2f ms\n", rounds, elapsed * 1000);
+    printf("server sent %llu requests, %llu calls, %llu bytes\n",
+           (unsigned long long)w.requests, (unsigned long long)w.calls, (unsigned long long)w.bytes);
+    printf("lines set %llu, deleted %llu; highlights added %llu, cleared %llu; commands %llu\n",
+           (unsigned long long)w.lines_set, (unsigned long long)w.lines_deleted,
+           (unsigned long long)w.highlights_added, (unsigned long long)w.highlights_cleared,
+           (unsigned long long)w.commands);
+    printf("buffer now: %zu lines, %zu highlights\n", b.lines.size(), b.highlights.size());
+    print_methods("actions", bench.actions, true);
+    print_methods("nvim api", s.methods, false);
+
+    mock.close();
+    server.join();
+    return 0;
+}
@@ -0,0 +1,34 @@
+#include "buffer_pool.hpp"
+
+#include <algorithm>
+
+namespace nvim {
+
+const size_t BufferPool::kMaxPooled;
+const size_t BufferPool::kMaxPooledSize;
+const size_t BufferPool::kMinBufferSize;
+
+msgpack::sbuffer BufferPool::acquire()
+{
+    if (free_.empty()) {
+        ++stats_.misses;
+        // Twice the typical message, so that most fit without a realloc.
+        return msgpack::sbuffer(std::max(typical_size_ * 2, kMinBufferSize));
+    }
+    ++stats_.hits;
+    msgpack::sbuffer sbuf = std::move(free_.back());
+    free_.pop_back();
+    return sbuf;
+}
+
+void BufferPool::release(msgpack::sbuffer &&sbuf)
+{
+    // sbuffer does not tell its capacity, but it grows by doubling, so the
+    // size it held is within a factor of two of it.
+    if (full() || sbuf.size() > kMaxPooledSize || sbuf.data() == nullptr)
+        return;
+    sbuf.clear();
+    free_.push_back(std::move(sbuf));
+}
+
+} //namespace nvim
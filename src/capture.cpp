@@ -0,0 +1,89 @@
+#include "capture.hpp"
+
+#include <boost/system/system_error.hpp>
+#include <algorithm>
+#include <cerrno>
+
+namespace nvim {
+
+CaptureWriter::CaptureWriter(const std::string &path) :
+    file_(std::fopen(path.c_str(), "wb")),
+    start_(std::chrono::steady_clock::now())
+{
+    if (!file_)
+        throw boost::system::system_error(errno, boost::system::system_category(), path);
+}
+
+CaptureWriter::~CaptureWriter()
+{
+    std::fclose(file_);
+}
+
+void CaptureWriter::write_head(Direction dir, size_t size)
+{
+    uint64_t us = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start_).count();
+    head_.clear();
+    msgpack::packer<msgpack::sbuffer> pk(&head_);
+    pk.pack_array(3);
+    pk.pack_uint8(static_cast<uint8_t>(dir));
+    pk.pack_uint64(us);
+    pk.pack_bin(static_cast<uint32_t>(size));
+    std::fwrite(head_.data(), 1, head_.size(), file_);
+}
+
+void CaptureWriter::write(Direction dir, const char *data, size_t size)
+{
+    write_head(dir, size);
+    std::fwrite(data, 1, size, file_);
+    // A session usually ends with nvim killing us, keep what we have.
+    std::fflush(file_);
+}
+
+void CaptureWriter::write(Direction dir, const std::vector<boost::asio::const_buffer> &bufs, size_t size)
+{
+    write_head(dir, size);
+    for (const auto &buf : bufs) {
+        if (size == 0)
+            break;
+        size_t n = std::min(size, boost::asio::buffer_size(buf));
+        std::fwrite(boost::asio::buffer_cast<const char *>(buf), 1, n, file_);
+        size -= n;
+    }
+    std::fflush(file_);
+}
+
+std::vector<CaptureRecord> read_capture(const std::string &path)
+{
+    std::FILE *file = std::fopen(path.c_str(), "rb");
+    if (!file)
+        throw boost::system::system_error(errno, boost::system::system_category(), path);
+
+    std::vector<CaptureRecord> records;
+    msgpack::unpacker unpacker;
+    msgpack::unpacked msg;
+    while (true) {
+        unpacker.reserve_buffer(64 * 1024);
+        size_t n = std::fread(unpacker.buffer(), 1, unpacker.buffer_capacity(), file);
+        if (n == 0)
+            break;
+        unpacker.buffer_consumed(n);
+        while (unpacker.next(msg)) {
+            const msgpack::object &obj = msg.get();
+            if (obj.type != msgpack::type::ARRAY || obj.via.array.size != 3
+                    || obj.via.array.ptr[2].type != msgpack::type::BIN)
+                continue;
+            const msgpack::object *a = obj.via.array.ptr;
+            const msgpack::object_bin &bin = a[2].via.bin;
+            records.push_back(CaptureRecord{
+                static_cast<Direction>(a[0].as<uint8_t>()),
+                a[1].as<uint64_t>(),
+                std::string(bin.ptr, bin.size),
+            });
+        }
+    }
+    std::fclose(file);
+    return records;
+}
+
+} //namespace nvim
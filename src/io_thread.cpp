@@ -0,0 +1,395 @@
+#include "io_thread.hpp"
+
+#include <boost/asio/error.hpp>
+#include <chrono>
+
+namespace nvim {
+
+const size_t IoThread::kRingSize;
+const size_t IoThread::kHighWater;
+const size_t IoThread::kLowWater;
+
+IoThread::IoThread(Socket &socket) :
+    socket_(socket),
+    out_(kRingSize),
+    in_(kRingSize),
+    recycled_(kRingSize),
+    waker_(std::make_shared<Waker>())
+{
+    waker_->io_ = this;
+}
+
+IoThread::~IoThread()
+{
+    {
+        std::lock_guard<std::mutex> lock(waker_->mutex_);
+        waker_->io_ = nullptr;
+    }
+    stop();
+}
+
+void Waker::wake()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (io_)
+        io_->interrupt();
+}
+
+#ifdef NVIM_HAS_EPOLL
+
+void IoThread::start()
+{
+    socket_.set_non_blocking();
+    reactor_.watch(socket_.read_handle(), socket_.write_handle());
+    thread_ = std::thread([this]() { run(); });
+}
+
+void IoThread::stop()
+{
+    if (!thread_.joinable())
+        return;
+    stopping_.store(true);
+    reactor_.wakeup();
+    thread_.join();
+    socket_.close();
+}
+
+void IoThread::wake()
+{
+    reactor_.wakeup();
+}
+
+void IoThread::run()
+{
+    while (!stopping_.load()) {
+        unsigned events = reactor_.wait();
+        if (closed_.load())
+            continue;  // only stop() is left to wait for
+
+        if (events & Reactor::kReadable) {
+            boost::system::error_code ec = socket_.read_messages(
+                [this](msgpack::unpacked &&msg) { on_message(std::move(msg)); });
+            if (ec != boost::asio::error::would_block) {
+                on_error(ec);
+                continue;
+            }
+        }
+        if (events & Reactor::kTimeout) {
+            on_error(boost::asio::error::timed_out);
+            continue;
+        }
+        if (events & (Reactor::kWritable | Reactor::kWakeup))
+            on_wakeup();
+    }
+}
+
+/// Write as much as the socket takes, with one writev() per round. When it
+/// would block, wait for it to become writable again, under kWriteTimeout.
+void IoThread::write_some()
+{
+    while (true) {
+        if (write_index_ == writing_.size()) {
+            recycle_written();
+            write_index_ = write_offset_ = 0;
+            msgpack::sbuffer sbuf(0);
+            while (out_.pop(sbuf)) {
+                writing_.push_back(std::move(sbuf));
+            }
+            notify_room();
+            if (writing_.empty()) {
+                write_scheduled_.store(false);
+                // A send() between the last pop and the store saw the flag
+                // still set and did not wake us, pick its message up here.
+                if (out_.empty() || write_scheduled_.exchange(true))
+                    return;
+                continue;
+            }
+        }
+
+        std::vector<boost::asio::const_buffer> bufs;
+        bufs.reserve(writing_.size() - write_index_);
+        bufs.push_back(boost::asio::buffer(writing_[write_index_].data() + write_offset_,
+                    writing_[write_index_].size() - write_offset_));
+        for (size_t i = write_index_ + 1; i < writing_.size(); ++i) {
+            bufs.push_back(boost::asio::buffer(writing_[i].data(), writing_[i].size()));
+        }
+
+        boost::system::error_code ec;
+        size_t n = socket_.write_some(bufs, ec);
+        if (ec == boost::asio::error::would_block) {
+            // The deadline runs from the last progress, later attempts
+            // (more messages sent meanwhile) do not extend it.
+            if (!write_timer_armed_) {
+                reactor_.arm_timer(kWriteTimeout);
+                write_timer_armed_ = true;
+            }
+            return;
+        }
+        if (ec) {
+            on_error(ec);
+            return;
+        }
+        if (write_timer_armed_) {
+            reactor_.disarm_timer();
+            write_timer_armed_ = false;
+        }
+        written(n);
+        n += write_offset_;
+        while (write_index_ < writing_.size() && n >= writing_[write_index_].size()) {
+            n -= writing_[write_index_].size();
+            ++write_index_;
+        }
+        write_offset_ = n;
+    }
+}
+
+#else // !NVIM_HAS_EPOLL
+
+void IoThread::start()
+{
+    socket_.async_read_messages(
+        [this](msgpack::unpacked &&msg) { on_message(std::move(msg)); },
+        [this](const boost::system::error_code &ec) { on_error(ec); });
+
+    work_.reset(new boost::asio::io_service::work(socket_.io_service()));
+    thread_ = std::thread([this]() { run(); });
+}
+
+void IoThread::stop()
+{
+    if (!thread_.joinable())
+        return;
+    work_.reset();
+    socket_.io_service().stop();
+    thread_.join();
+    socket_.close();
+}
+
+void IoThread::wake()
+{
+    socket_.io_service().post([this]() { on_wakeup(); });
+}
+
+void IoThread::run()
+{
+    socket_.io_service().run();
+}
+
+/// Write everything queued so far with one gather write. Whatever is sent
+/// meanwhile goes out with the next one.
+void IoThread::write_some()
+{
+    if (!writing_.empty())
+        return;  // in flight, its completion comes back here
+
+    msgpack::sbuffer sbuf(0);
+    while (out_.pop(sbuf)) {
+        writing_.push_back(std::move(sbuf));
+    }
+    notify_room();
+    if (writing_.empty()) {
+        write_scheduled_.store(false);
+        // A send() between the last pop and the store saw the flag still
+        // set and did not post, pick its message up here.
+        if (!out_.empty() && !write_scheduled_.exchange(true))
+            write_some();
+        return;
+    }
+
+    std::vector<boost::asio::const_buffer> bufs;
+    bufs.reserve(writing_.size());
+    size_t total = 0;
+    for (const msgpack::sbuffer &b : writing_) {
+        bufs.push_back(boost::asio::buffer(b.data(), b.size()));
+        total += b.size();
+    }
+    socket_.async_write(bufs, [this, total](const boost::system::error_code &ec) {
+        recycle_written();
+        if (ec) {
+            on_error(ec);
+            return;
+        }
+        written(total);
+        write_some();
+    });
+}
+
+#endif // NVIM_HAS_EPOLL
+
+/// Hand the buffers of the finished write back to the application's
+/// BufferPool; those that do not fit are freed here.
+void IoThread::recycle_written()
+{
+    for (msgpack::sbuffer &sbuf : writing_) {
+        recycled_.push(std::move(sbuf));
+    }
+    writing_.clear();
+}
+
+void IoThread::on_wakeup()
+{
+    if (closed_.load())
+        return;
+    if (drain_requested_.exchange(false))
+        drain_backlog();
+    // Stays set while anything is left to write.
+    if (write_scheduled_.load())
+        write_some();
+}
+
+void IoThread::send(msgpack::sbuffer &&sbuf)
+{
+    if (queued_bytes_.load() > kHighWater)
+        wait_for_room();
+    // Counted before the push, the I/O thread may write it right away.
+    queued_bytes_.fetch_add(sbuf.size());
+    while (!out_.push(std::move(sbuf))) {
+        if (closed_.load())
+            return;  // nobody will ever write it
+        wait_for_room();
+    }
+    schedule_write();
+}
+
+/// nvim reads slower than we produce: sleep until the I/O thread has made
+/// room, instead of letting the queue (and our memory) grow without bound.
+void IoThread::wait_for_room()
+{
+    schedule_write();
+    std::unique_lock<std::mutex> lock(mutex_);
+    send_waiting_.store(true);
+    while (!closed_.load() && (out_.full() || queued_bytes_.load() > kLowWater)) {
+        room_.wait(lock);
+    }
+    send_waiting_.store(false);
+}
+
+void IoThread::schedule_write()
+{
+    if (!write_scheduled_.exchange(true))
+        wake();
+}
+
+void IoThread::request_drain()
+{
+    drain_requested_.store(true);
+    wake();
+}
+
+void IoThread::on_message(msgpack::unpacked &&msg)
+{
+    if (!backlog_.empty() || !in_.push(std::move(msg))) {
+        backlog_.push_back(std::move(msg));
+        backlogged_.store(true);
+    }
+    notify();
+}
+
+void IoThread::drain_backlog()
+{
+    while (!backlog_.empty() && in_.push(std::move(backlog_.front()))) {
+        backlog_.pop_front();
+    }
+    if (!backlog_.empty())
+        backlogged_.store(true);
+    notify();
+}
+
+/// The connection is gone: nothing is read or written any more, the
+/// application gets the error once it has taken the messages read before.
+void IoThread::on_error(const boost::system::error_code &ec)
+{
+    if (closed_.load())
+        return;
+#ifdef NVIM_HAS_EPOLL
+    reactor_.unwatch();
+    reactor_.disarm_timer();
+#endif
+    // Whatever is still backlogged is handed over before the error.
+    while (!backlog_.empty() && in_.push(std::move(backlog_.front()))) {
+        backlog_.pop_front();
+    }
+    error_ = ec;
+    closed_.store(true);
+    notify();
+    notify_room();
+}
+
+void IoThread::written(size_t bytes)
+{
+    queued_bytes_.fetch_sub(bytes);
+    notify_room();
+}
+
+void IoThread::notify_room()
+{
+    // Same pairing as notify(), with send_waiting_ in wait_for_room().
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (send_waiting_.load()) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        room_.notify_one();
+    }
+}
+
+void IoThread::notify()
+{
+    // Pairs with the waiting_ store in receive(): either the consumer sees
+    // the new message before sleeping, or we see it waiting.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiting_.load()) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ready_.notify_one();
+    }
+}
+
+void IoThread::interrupt()
+{
+    // Stored before taking the lock receive() checks it under.
+    interrupted_.store(true);
+    std::lock_guard<std::mutex> lock(mutex_);
+    ready_.notify_one();
+}
+
+bool IoThread::receive(msgpack::unpacked &msg, double timeout_sec, bool interruptible)
+{
+    auto deadline = std::chrono::steady_clock::now()
+        + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double>(timeout_sec));
+
+    while (!in_.pop(msg)) {
+        if (backlogged_.exchange(false))
+            request_drain();
+
+        if (closed_.load()) {
+            // Messages read before the error are still delivered.
+            if (in_.pop(msg))
+                return true;
+            throw boost::system::system_error(error_);
+        }
+        if (interruptible && interrupted_.exchange(false))
+            return false;
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        waiting_.store(true);
+        bool timed_out = false;
+        if (in_.empty() && !backlogged_.load() && !closed_.load() &&
+                !(interruptible && interrupted_.load()))
+            timed_out = ready_.wait_until(lock, deadline) == std::cv_status::timeout;
+        waiting_.store(false);
+        if (timed_out && in_.empty())
+            return false;
+    }
+    if (backlogged_.exchange(false))
+        request_drain();
+    return true;
+}
+
+bool IoThread::try_receive(msgpack::unpacked &msg)
+{
+    bool got = in_.pop(msg);
+    if (backlogged_.exchange(false))
+        request_drain();
+    return got;
+}
+
+} //namespace nvim
@@ -0,0 +1,248 @@
+#include "log.hpp"
+#include "spsc_ring.hpp"
+#include <condition_variable>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace nvim {
+
+const size_t Logger::kMessageSize;
+const size_t Logger::kRingSize;
+std::atomic<int> Logger::level_{TREE_LOG_LEVEL};
+
+namespace {
+
+// The records of one thread. Only the first record after the writer
+// drained the ring wakes it, a burst costs the producer one notify.
+struct Ring {
+    explicit Ring(size_t size) : records(size) {}
+
+    SpscRing<Logger::Record> records;
+    // Set by the producer with its first record, cleared by the writer
+    // before it drains the ring.
+    std::atomic<bool> queued{false};
+};
+
+// Sleeps until a ring gets its first record, a flush or stop().
+class Writer {
+public:
+    Writer() : file_(stderr) {
+        thread_ = std::thread([this] { run(); });
+    }
+
+    std::shared_ptr<Ring> add_ring() {
+        std::lock_guard<std::mutex> lock(rings_mutex_);
+        rings_.push_back(std::make_shared<Ring>(Logger::kRingSize));
+        return rings_.back();
+    }
+
+    void open(const char *path) {
+        FILE *f = std::fopen(path, "a");
+        if (!f) {
+            std::perror(path);
+            return;
+        }
+        std::lock_guard<std::mutex> lock(file_mutex_);
+        if (file_ != stderr)
+            std::fclose(file_);
+        file_ = f;
+    }
+
+    // A ring has something to write.
+    void notify() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queued_ = true;
+        wake_.notify_one();
+    }
+
+    void flush() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (stop_)
+            return;
+        uint64_t ticket = ++flush_requested_;
+        wake_.notify_one();
+        flushed_cv_.wait(lock, [&] { return flushed_ >= ticket || stop_; });
+    }
+
+    // At exit: write what is left, later records are written directly.
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+            wake_.notify_one();
+        }
+        thread_.join();
+        stopped_.store(true, std::memory_order_release);
+    }
+
+    bool stopped() const { return stopped_.load(std::memory_order_acquire); }
+
+    void write_now(const Logger::Record &r) {
+        std::lock_guard<std::mutex> lock(file_mutex_);
+        print(r);
+        std::fflush(file_);
+    }
+
+    std::atomic<uint64_t> dropped{0};
+
+private:
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!stop_) {
+            wake_.wait(lock, [this] {
+                return stop_ || queued_ || flush_requested_ != flushed_;
+            });
+            queued_ = false;
+            uint64_t requested = flush_requested_;
+            lock.unlock();
+            drain();
+            lock.lock();
+            flushed_ = requested;
+            flushed_cv_.notify_all();
+        }
+        lock.unlock();
+        drain();
+    }
+
+    void drain() {
+        std::vector<std::shared_ptr<Ring>> rings;
+        {
+            std::lock_guard<std::mutex> lock(rings_mutex_);
+            rings = rings_;
+        }
+        std::lock_guard<std::mutex> lock(file_mutex_);
+        bool wrote = false;
+        Logger::Record r;
+        for (const auto &ring : rings) {
+            // Cleared first: a record pushed from now on either is popped
+            // below or finds the flag clear and notifies again.
+            ring->queued.store(false);
+            while (ring->records.pop(r)) {
+                print(r);
+                wrote = true;
+            }
+        }
+        uint64_t n = dropped.exchange(0, std::memory_order_relaxed);
+        if (n > 0) {
+            std::fprintf(file_, "log: %llu records dropped, ring full\n", (unsigned long long)n);
+            wrote = true;
+        }
+        if (wrote)
+            std::fflush(file_);
+
+        // Rings of threads that are gone, once empty.
+        std::lock_guard<std::mutex> rings_lock(rings_mutex_);
+        for (auto it = rings_.begin(); it != rings_.end();) {
+            if (it->use_count() == 2 && (*it)->records.empty())  // rings_ and the copy above
+                it = rings_.erase(it);
+            else
+                ++it;
+        }
+    }
+
+    void print(const Logger::Record &r) {
+        static const char kLevels[] = "DIWE";
+        std::time_t t = std::chrono::system_clock::to_time_t(r.time);
+        int ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                r.time.time_since_epoch()).count() % 1000;
+        std::tm tm;
+#ifdef _WIN32
+        localtime_s(&tm, &t);
+#else
+        localtime_r(&t, &tm);
+#endif
+        const char *file = std::strrchr(r.file, '/');
+        size_t len = std::strlen(r.msg);
+        // INFO style messages end with their own newline.
+        if (len > 0 && r.msg[len - 1] == '\n')
+            --len;
+        std::fprintf(file_, "%02d:%02d:%02d.%03d %c %s:%d %.*s\n",
+                     tm.tm_hour, tm.tm_min, tm.tm_sec, ms,
+                     kLevels[static_cast<int>(r.level)], file ? file + 1 : r.file, r.line,
+                     (int)len, r.msg);
+    }
+
+    std::thread thread_;
+    std::mutex mutex_;            // stop_, queued_, flush_requested_, flushed_
+    std::condition_variable wake_;
+    std::condition_variable flushed_cv_;
+    bool stop_ = false;
+    bool queued_ = false;
+    uint64_t flush_requested_ = 0;
+    uint64_t flushed_ = 0;
+    std::atomic<bool> stopped_{false};
+
+    std::mutex rings_mutex_;
+    std::vector<std::shared_ptr<Ring>> rings_;
+
+    std::mutex file_mutex_;
+    FILE *file_;
+};
+
+// Never destroyed, threads may log while static objects go away.
+Writer &writer()
+{
+    static Writer *w = [] {
+        Writer *w = new Writer;
+        std::atexit([] { writer().stop(); });
+        return w;
+    }();
+    return *w;
+}
+
+} // namespace
+
+bool Logger::parse_level(boost::string_ref name, LogLevel &level)
+{
+    static const char *const kNames[] = {"debug", "info", "warn", "error", "off"};
+    for (int i = 0; i <= static_cast<int>(LogLevel::kOff); ++i) {
+        if (name == kNames[i]) {
+            level = static_cast<LogLevel>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+void Logger::open(const char *path)
+{
+    writer().open(path);
+}
+
+void Logger::write(LogLevel level, const char *file, int line, const char *fmt, ...)
+{
+    Record r;
+    r.time = std::chrono::system_clock::now();
+    r.level = level;
+    r.file = file;
+    r.line = line;
+    va_list ap;
+    va_start(ap, fmt);
+    std::vsnprintf(r.msg, sizeof(r.msg), fmt, ap);
+    va_end(ap);
+
+    Writer &w = writer();
+    if (w.stopped()) {
+        w.write_now(r);
+        return;
+    }
+    thread_local std::shared_ptr<Ring> ring = w.add_ring();
+    if (!ring->records.push(std::move(r)))
+        w.dropped.fetch_add(1, std::memory_order_relaxed);
+    if (!ring->queued.exchange(true))
+        w.notify();
+}
+
+void Logger::flush()
+{
+    writer().flush();
+}
+
+} //namespace nvim
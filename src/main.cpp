@@ -1,124 +1,93 @@
 #include "nvim.hpp"
-#include "app/app.h"
-#include "util.h"
-#include <iostream>
+#include "log.hpp"
+#include "app/eventloop.h"
+#include <boost/asio/local/stream_protocol.hpp>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <string>
 #include <locale>
+#include <thread>
+#include <sys/socket.h>
+#include <unistd.h>
 
-using std::cerr;
-using std::cout;
-using std::endl;
 using std::string;
 #define BOOST_VARIANT_USE_RELAXED_GET_BY_DEFAULT
 
-// TODO: 临时
-void eventloop(nvim::Nvim &nvim) {
-    using nvim::Object;
-    nvim::Array info = nvim.get_api_info();
-    int chan_id = info[0].as_uint64_t();
-    cout << "type(api-metadata): " << type_name(info[1]) << endl;
-    cout << "Channel Id: " << chan_id << endl;
-
-    tree::App app(&nvim, chan_id);
-
-    string line = nvim.get_current_line();
-    cout << "get_current_line = " << line << endl;
-
-    cout << "eventloop started" << endl;
-    while(true) {
-        msgpack::unpacked result;
-        try {
-            result = nvim.client_.socket_.read2(10);
-        }catch(std::exception& e) {
-            cout << e.what() << endl;
-            continue;
+// tree --daemon PATH: one process for every nvim connecting to PATH. Each
+// connection is served by an App on a thread of its own, directory listings
+// and git status are shared between them (app/cache.h).
+static int daemon_main(const string &path)
+{
+    using boost::asio::local::stream_protocol;
+    boost::asio::io_service io_service;
+    stream_protocol::endpoint ep(path);
+    {
+        // A socket file nobody accepts on is left over from a dead daemon.
+        stream_protocol::socket probe(io_service);
+        boost::system::error_code ec;
+        probe.connect(ep, ec);
+        if (!ec) {
+            LOG_ERROR("a daemon is already listening on %s", path.c_str());
+            return 1;
         }
-        msgpack::object obj(result.get());
-        if (obj.type != msgpack::type::ARRAY) {
-            cerr << "Received Invalid msgpack: not an array";
-            continue;
+        ::unlink(path.c_str());
+    }
+    stream_protocol::acceptor acceptor(io_service, ep);
+    LOG_INFO("daemon listening on %s", path.c_str());
+
+    while (true) {
+        int fd = ::accept(acceptor.native_handle(), nullptr, nullptr);
+        if (fd < 0) {
+            if (errno == EINTR)
+                continue;
+            LOG_ERROR("accept: %s", std::strerror(errno));
+            return 1;
         }
-
-        uint64_t type = obj.via.array.ptr[0].via.u64;
-
-        // cout << "res = " << obj << endl;
-        switch(type) {
-        case 0:
-            if (obj.via.array.ptr[1].type != msgpack::type::POSITIVE_INTEGER) {
-                cerr << "Received Invalid request: msg id MUST be a positive integer";
-                return;
-            }
-            if (obj.via.array.ptr[2].type != msgpack::type::BIN &&
-                    obj.via.array.ptr[2].type != msgpack::type::STR) {
-                cerr << "Received Invalid request: method MUST be a String" << obj.via.array.ptr[2];
-                return;
-            }
-            if (obj.via.array.ptr[3].type != msgpack::type::ARRAY) {
-                cerr << "Invalid request: arguments MUST be an array";
-                return;
-            }
-            {
-                // [type(0), msgid, method, params]
-                msgpack::type::tuple<int64_t, int64_t, Object, Object> msg;
-                obj.convert(msg);
-                int msgid = msg.get<1>();
-                string method = msg.get<2>().as_string();
-                cout << "msgid: " << msgid << endl;
-                cout << "method: " << method << endl;
-                cout << "type(msg.get<3>()): " << type_name(msg.get<3>()) << endl;
-                auto argv = msg.get<3>().as_vector();
-
-                // 涉及 tree.nvim 通信协议
-                auto args = argv.front().as_vector();
-
-                app.handleRequest(nvim.client_, msgid, method, args);
-            }
-            break;
-        case 1:
-            if (obj.via.array.ptr[1].type != msgpack::type::POSITIVE_INTEGER) {
-                cerr << "Received Invalid response: msg id MUST be a positive integer";
-                return;
-            }
-            break;
-        case 2:
-            {
-                Object methodName;
-                // [type(2), method, params]
-                msgpack::type::tuple<int64_t, Object, Object> msg;
-                obj.convert(msg);
-                string method = msg.get<1>().as_string();
-                cout << "method: " << method << endl;
-                cout << "type(msg.get<2>()): " << type_name(msg.get<2>()) << endl;
-                auto argv = msg.get<2>().as_vector();
-
-                // 涉及 tree.nvim 通信协议
-                auto args = argv.front().as_vector();
-
-                app.handleNvimNotification(method, args);
+        std::thread([fd] {
+            nvim::Nvim nvim;
+            try {
+                nvim.connect_fd(fd);
+                tree::eventloop(nvim);
+            } catch (std::exception &e) {
+                // Gone before the greeting was answered, the others go on.
+                LOG_WARN("client %d: %s", fd, e.what());
             }
-
-            break;
-        default:
-            cerr << "Unsupported msg type" << type;
-        }
+        }).detach();
     }
 }
 
 int main(int argc, char *argv[])
 {
-    cout << "argc:" << argc << " argv[1]:"<< argv[1] << endl;
     std::locale::global(std::locale(""));
+    // TREE_LOG_FILE=file instead of stderr, TREE_LOG_LEVEL=debug|info|warn|error|off
+    if (const char *file = std::getenv("TREE_LOG_FILE"))
+        nvim::Logger::open(file);
+    nvim::LogLevel level;
+    if (const char *name = std::getenv("TREE_LOG_LEVEL")) {
+        if (nvim::Logger::parse_level(name, level))
+            nvim::Logger::set_level(level);
+    }
+    if (argc > 2 && string(argv[1]) == "--daemon")
+        return daemon_main(argv[2]);
+
     nvim::Nvim nvim;
+    // TREE_CAPTURE=file records the session, for tree-replay.
+    if (const char *capture = std::getenv("TREE_CAPTURE"))
+        nvim.client_.socket_.start_capture(capture);
     // nvim.connect_tcp("localhost", "6666");
-    nvim.connect_pipe(argv[1]);
-
-    string expr = "( 3 + 2 ) * 4";
-    nvim::Object rv = nvim.eval(expr);
-    cout << type_name(rv) << endl;
-    uint64_t res = rv.as_uint64_t();
-    printf("nvim_eval('%s') = %llu\n", expr.c_str(), res);
+    // Spawned with jobstart(cmd, {'rpc': v:true}): the channel is on
+    // stdin/stdout, which must see nothing else, hence no output before
+    // connect_stdio() sends cout to stderr.
+    if (argc < 2 || string(argv[1]) == "--stdio") {
+        nvim.connect_stdio();
+    } else {
+        nvim.connect_pipe(argv[1]);
+    }
+    LOG_DEBUG("argc:%d argv[1]:%s", argc, argc < 2 ? "" : argv[1]);
 
-    eventloop(nvim);
+    tree::eventloop(nvim);
 
     return 0;
 }
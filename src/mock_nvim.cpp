@@ -0,0 +1,425 @@
+#include "mock_nvim.hpp"
+
+#include <boost/asio/write.hpp>
+#include <algorithm>
+#include <cctype>
+#include <limits>
+#include <stdexcept>
+#include <unistd.h>
+
+using boost::asio::local::stream_protocol;
+
+namespace nvim {
+
+namespace {
+
+// ext types of the handles, as in nvim's api metadata
+const int8_t kBufferExt = 0;
+
+void pack_handle(msgpack::packer<msgpack::sbuffer> &pk, int8_t type, int64_t handle)
+{
+    msgpack::sbuffer payload;
+    msgpack::packer<msgpack::sbuffer>(&payload).pack(handle);
+    pk.pack_ext(payload.size(), type);
+    pk.pack_ext_body(payload.data(), payload.size());
+}
+
+/// Integer expressions only: + - * / and parentheses, enough for what the
+/// server evaluates.
+class Expr {
+public:
+    explicit Expr(boost::string_ref s) : s_(s) {}
+
+    int64_t eval() {
+        int64_t v = sum();
+        skip_space();
+        if (i_ != s_.size())
+            throw std::invalid_argument("Failed to evaluate expression");
+        return v;
+    }
+
+private:
+    int64_t sum() {
+        int64_t v = product();
+        while (true) {
+            char op = peek();
+            if (op != '+' && op != '-')
+                return v;
+            ++i_;
+            int64_t r = product();
+            v = op == '+' ? v + r : v - r;
+        }
+    }
+
+    int64_t product() {
+        int64_t v = atom();
+        while (true) {
+            char op = peek();
+            if (op != '*' && op != '/')
+                return v;
+            ++i_;
+            int64_t r = atom();
+            if (op == '/' && r == 0)
+                throw std::invalid_argument("E41: Division by zero");
+            v = op == '*' ? v * r : v / r;
+        }
+    }
+
+    int64_t atom() {
+        char c = peek();
+        if (c == '(') {
+            ++i_;
+            int64_t v = sum();
+            if (peek() != ')')
+                throw std::invalid_argument("Failed to evaluate expression");
+            ++i_;
+            return v;
+        }
+        if (c == '-') {
+            ++i_;
+            return -atom();
+        }
+        if (!std::isdigit(static_cast<unsigned char>(c)))
+            throw std::invalid_argument("Failed to evaluate expression");
+        int64_t v = 0;
+        while (i_ < s_.size() && std::isdigit(static_cast<unsigned char>(s_[i_])))
+            v = v * 10 + (s_[i_++] - '0');
+        return v;
+    }
+
+    char peek() {
+        skip_space();
+        return i_ < s_.size() ? s_[i_] : '\0';
+    }
+
+    void skip_space() {
+        while (i_ < s_.size() && s_[i_] == ' ')
+            ++i_;
+    }
+
+    boost::string_ref s_;
+    size_t i_ = 0;
+};
+
+/// nvim_buf_set_lines() indexing: negative counts from past the end.
+size_t line_index(int64_t idx, size_t count, bool strict)
+{
+    if (idx < 0)
+        idx += int64_t(count) + 1;
+    if (idx < 0 || idx > int64_t(count)) {
+        if (strict)
+            throw std::out_of_range("Index out of bounds");
+        idx = std::max<int64_t>(0, std::min<int64_t>(idx, count));
+    }
+    return size_t(idx);
+}
+
+} // namespace
+
+MockNvim::MockNvim(const std::string &path) :
+    acceptor_(io_service_),
+    socket_(io_service_),
+    path_(path)
+{
+    ::unlink(path.c_str());
+    stream_protocol::endpoint ep(path);
+    acceptor_.open(ep.protocol());
+    acceptor_.bind(ep);
+    acceptor_.listen();
+    state_.buffers[1];
+}
+
+MockNvim::~MockNvim()
+{
+    close();
+    if (thread_.joinable())
+        thread_.join();
+    ::unlink(path_.c_str());
+}
+
+void MockNvim::accept()
+{
+    acceptor_.accept(socket_);
+    thread_ = std::thread([this] { serve(); });
+}
+
+void MockNvim::close()
+{
+    boost::system::error_code ec;
+    socket_.shutdown(stream_protocol::socket::shutdown_both, ec);
+}
+
+MockNvim::State MockNvim::state() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return state_;
+}
+
+bool MockNvim::wait(const std::function<bool(const State &)> &pred, double timeout_sec)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    return changed_.wait_for(lock, std::chrono::duration<double>(timeout_sec),
+                             [&] { return pred(state_); });
+}
+
+void MockNvim::write(const msgpack::sbuffer &sbuf)
+{
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    boost::system::error_code ec;
+    // A server that is gone shows up in serve(), as eof.
+    boost::asio::write(socket_, boost::asio::buffer(sbuf.data(), sbuf.size()), ec);
+}
+
+void MockNvim::serve()
+{
+    msgpack::unpacker unpacker;
+    msgpack::unpacked msg;
+    boost::system::error_code ec;
+    size_t parsed = 0;
+    while (true) {
+        unpacker.reserve_buffer(64 * 1024);
+        size_t n = socket_.read_some(
+                boost::asio::buffer(unpacker.buffer(), unpacker.buffer_capacity()), ec);
+        if (ec)
+            break;
+        unpacker.buffer_consumed(n);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            state_.work.bytes += n;
+        }
+        while (unpacker.next(msg)) {
+            size_t bytes = unpacker.parsed_size() - parsed;
+            parsed = unpacker.parsed_size();
+            const msgpack::object &obj = msg.get();
+            if (obj.type != msgpack::type::ARRAY || obj.via.array.size < 3)
+                continue;
+            if (obj.via.array.ptr[0].via.u64 == 1) {
+                // [1, msgid, error, result]: to one of our requests
+                std::lock_guard<std::mutex> lock(mutex_);
+                responses_[obj.via.array.ptr[1].via.u64] = std::move(msg);
+                changed_.notify_all();
+                continue;
+            }
+            handle_request(obj, bytes);
+        }
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = true;
+    changed_.notify_all();
+}
+
+void MockNvim::handle_request(const msgpack::object &obj, size_t bytes)
+{
+    // [0, msgid, method, args] or [2, method, args]
+    bool is_request = obj.via.array.ptr[0].via.u64 == 0;
+    const msgpack::object *a = obj.via.array.ptr + (is_request ? 2 : 1);
+    boost::string_ref method = ObjectRef(a[0]).as_string_ref();
+    ObjectRef args(a[1]);
+
+    msgpack::sbuffer result;
+    std::string err;
+    bool ok;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++state_.work.requests;
+        state_.methods.entry(method).add_bytes(bytes);
+        if (method == "nvim_call_atomic") {
+            call_atomic(args.at(0), result);
+            ok = true;
+        } else {
+            ok = call(method, args, result, err);
+        }
+        changed_.notify_all();
+    }
+    if (!is_request)
+        return;
+
+    msgpack::sbuffer sbuf;
+    Packer pk(&sbuf);
+    pk.pack_array(4);
+    pk.pack_uint8(1);
+    pk.pack_uint64(obj.via.array.ptr[1].via.u64);
+    if (ok) {
+        pk.pack_nil();
+        sbuf.write(result.data(), result.size());
+    } else {
+        // [type (0: exception), message]
+        pk.pack_array(2);
+        pk.pack_uint8(0);
+        pk.pack(err);
+        pk.pack_nil();
+    }
+    write(sbuf);
+}
+
+/// [[results...], error]: error is nil or [index, type, message] of the
+/// call that failed, the calls after it are not run.
+void MockNvim::call_atomic(const ObjectRef &calls, msgpack::sbuffer &out)
+{
+    msgpack::sbuffer results;
+    uint32_t done = 0;
+    std::string err;
+    for (; done < calls.size(); ++done) {
+        ObjectRef c = calls.at(done);
+        boost::string_ref method = c.at(0).as_string_ref();
+        state_.methods.entry(method).add_bytes(0);  // bytes are the batch's
+        if (!call(method, c.at(1), results, err))
+            break;
+    }
+
+    Packer pk(&out);
+    pk.pack_array(2);
+    pk.pack_array(done);
+    out.write(results.data(), results.size());
+    if (done == calls.size()) {
+        pk.pack_nil();
+    } else {
+        pk.pack_array(3);
+        pk.pack_uint32(done);
+        pk.pack_uint8(0);
+        pk.pack(err);
+    }
+}
+
+MockNvim::Buffer &MockNvim::buffer(const ObjectRef &handle)
+{
+    int64_t id = handle.as_int();
+    auto it = state_.buffers.find(id == 0 ? state_.current_buffer : id);
+    if (it == state_.buffers.end())
+        throw std::invalid_argument("Invalid buffer id: " + std::to_string(id));
+    return it->second;
+}
+
+bool MockNvim::call(boost::string_ref method, const ObjectRef &args,
+                    msgpack::sbuffer &out, std::string &err)
+{
+    State &s = state_;
+    Work &w = s.work;
+    Packer pk(&out);
+    ++w.calls;
+    try {
+        if (method == "nvim_buf_set_lines") {
+            // (buffer, start, end, strict, replacement)
+            Buffer &b = buffer(args.at(0));
+            bool strict = args.at(3).as_bool();
+            size_t start = line_index(args.at(1).as_int(), b.lines.size(), strict);
+            size_t end = line_index(args.at(2).as_int(), b.lines.size(), strict);
+            if (start > end)
+                throw std::out_of_range("'start' is higher than 'end'");
+            ObjectRef repl = args.at(4);
+            std::vector<std::string> lines;
+            lines.reserve(repl.size());
+            for (uint32_t i = 0; i < repl.size(); ++i)
+                lines.push_back(repl.at(i).as_string());
+
+            b.lines.erase(b.lines.begin() + start, b.lines.begin() + end);
+            b.lines.insert(b.lines.begin() + start, lines.begin(), lines.end());
+            if (b.lines.empty())
+                b.lines.emplace_back();  // a buffer always has a line
+            // Highlights of the replaced lines go with them, those below move.
+            int64_t shift = int64_t(lines.size()) - int64_t(end - start);
+            auto &hls = b.highlights;
+            hls.erase(std::remove_if(hls.begin(), hls.end(), [&](const Highlight &h) {
+                return h.line >= int64_t(start) && h.line < int64_t(end);
+            }), hls.end());
+            for (Highlight &h : hls) {
+                if (h.line >= int64_t(end))
+                    h.line += shift;
+            }
+            w.lines_set += lines.size();
+            w.lines_deleted += end - start;
+            pk.pack_nil();
+        } else if (method == "nvim_buf_add_highlight") {
+            // (buffer, ns_id, hl_group, line, col_start, col_end)
+            Buffer &b = buffer(args.at(0));
+            int64_t ns = args.at(1).as_int();
+            int64_t line = args.at(3).as_int();
+            if (line < 0 || line >= int64_t(b.lines.size()))
+                throw std::out_of_range("Line number outside range");
+            if (ns == 0)
+                ns = next_ns_++;
+            b.highlights.push_back(Highlight{ns, args.at(2).as_string(), line,
+                                             args.at(4).as_int(), args.at(5).as_int()});
+            ++w.highlights_added;
+            pk.pack(ns);
+        } else if (method == "nvim_buf_clear_namespace") {
+            // (buffer, ns_id, line_start, line_end)
+            Buffer &b = buffer(args.at(0));
+            int64_t ns = args.at(1).as_int();
+            int64_t sl = args.at(2).as_int();
+            int64_t el = args.at(3).as_int();
+            if (el < 0)
+                el = std::numeric_limits<int64_t>::max();
+            auto &hls = b.highlights;
+            size_t before = hls.size();
+            hls.erase(std::remove_if(hls.begin(), hls.end(), [&](const Highlight &h) {
+                return (ns < 0 || h.ns_id == ns) && h.line >= sl && h.line < el;
+            }), hls.end());
+            w.highlights_cleared += before - hls.size();
+            pk.pack_nil();
+        } else if (method == "nvim_buf_get_lines") {
+            // (buffer, start, end, strict)
+            Buffer &b = buffer(args.at(0));
+            bool strict = args.at(3).as_bool();
+            size_t start = line_index(args.at(1).as_int(), b.lines.size(), strict);
+            size_t end = std::max(start, line_index(args.at(2).as_int(), b.lines.size(), strict));
+            pk.pack_array(end - start);
+            for (size_t i = start; i < end; ++i)
+                pk.pack(b.lines[i]);
+        } else if (method == "nvim_buf_line_count") {
+            pk.pack(buffer(args.at(0)).lines.size());
+        } else if (method == "nvim_buf_set_name") {
+            buffer(args.at(0)).name = args.at(1).as_string();
+            pk.pack_nil();
+        } else if (method == "nvim_buf_set_option" || method == "nvim_set_var") {
+            pk.pack_nil();
+        } else if (method == "nvim_buf_attach") {
+            buffer(args.at(0));
+            pk.pack(true);
+        } else if (method == "nvim_create_buf") {
+            int64_t id = s.buffers.rbegin()->first + 1;
+            s.buffers[id];
+            s.last_created = id;
+            pack_handle(pk, kBufferExt, id);
+        } else if (method == "nvim_create_namespace") {
+            std::string name = args.at(0).as_string();
+            int64_t ns;
+            if (name.empty()) {
+                ns = next_ns_++;
+            } else {
+                auto it = s.namespaces.find(name);
+                ns = it != s.namespaces.end() ? it->second : (s.namespaces[name] = next_ns_++);
+            }
+            pk.pack(ns);
+        } else if (method == "nvim_win_set_cursor") {
+            // (window, [row, col])
+            ObjectRef pos = args.at(1);
+            s.cursor_row = pos.at(0).as_int();
+            s.cursor_col = pos.at(1).as_int();
+            pk.pack_nil();
+        } else if (method == "nvim_get_current_line") {
+            const Buffer &b = s.buffers[s.current_buffer];
+            int64_t row = s.cursor_row - 1;
+            pk.pack(row >= 0 && row < int64_t(b.lines.size()) ? b.lines[row] : std::string());
+        } else if (method == "nvim_eval") {
+            pk.pack(Expr(args.at(0).as_string_ref()).eval());
+        } else if (method == "nvim_get_api_info") {
+            // [channel id, metadata]
+            pk.pack_array(2);
+            pk.pack_uint8(1);
+            pk.pack_map(0);
+        } else if (method == "nvim_command" || method == "nvim_execute_lua"
+                   || method == "nvim_call_function") {
+            ++w.commands;
+            pk.pack_nil();
+        } else {
+            throw std::invalid_argument("Invalid method: " + method.to_string());
+        }
+    } catch (std::exception &e) {
+        err = e.what();
+        return false;
+    }
+    return true;
+}
+
+} //namespace nvim
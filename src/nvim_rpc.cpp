@@ -0,0 +1,198 @@
+#include "nvim_rpc.hpp"
+#include "log.hpp"
+#include "util.h"
+
+namespace nvim {
+
+static constexpr Method kCallAtomic{"nvim_call_atomic", "\xb0" "nvim_call_atomic", 17};
+
+/// Route a response to the handler registered for its msgid.
+/// Returns false for requests and notifications, which are left to the caller.
+bool NvimRPC::handle_response(const msgpack::unpacked &msg)
+{
+    const msgpack::object &obj = msg.get();
+    if (obj.type != msgpack::type::ARRAY || obj.via.array.size != 4)
+        return false;
+    const msgpack::object *a = obj.via.array.ptr;
+    if (a[0].type != msgpack::type::POSITIVE_INTEGER || a[0].via.u64 != RESPONSE)
+        return false;
+
+    if (a[1].type != msgpack::type::POSITIVE_INTEGER) {
+        LOG_ERROR("Received Invalid response: msg id MUST be a positive integer");
+        return true;
+    }
+    uint64_t msgid = a[1].via.u64;
+    auto it = pending_.find(msgid);
+    if (it == pending_.end()) {
+        // async_call: nobody waits for the result, only report failures.
+        if (!a[2].is_nil())
+            LOG_WARN("async request %llu failed: %s", (unsigned long long)msgid, dump(a[2]).c_str());
+        return true;
+    }
+    // Erase first, the handler may send (and wait for) further requests.
+    Pending pending = std::move(it->second);
+    pending_.erase(it);
+    pending.stats->add_latency(MethodStats::Clock::now() - pending.sent);
+    pending.handler(a[2], a[3]);
+    return true;
+}
+
+void NvimRPC::add_pending(uint64_t msgid, ResponseHandler &&handler,
+                          MethodStats::Entry &stats, MethodStats::Clock::time_point sent)
+{
+    // Nothing is read between writing the request and this, its response
+    // cannot have been handled yet.
+    pending_.emplace(msgid, Pending{std::move(handler), &stats, sent});
+}
+
+uint64_t NvimRPC::send_atomic(msgpack::sbuffer &&calls, uint32_t count, ResponseHandler handler)
+{
+    uint64_t msgid = msgid_++;
+    auto sent = MethodStats::Clock::now();
+
+    msgpack::sbuffer sbuf = acquire_buffer();
+    detail::Packer pk(&sbuf);
+    sbuf.write(detail::kRequestHead, detail::kRequestHeadSize);
+    pk << msgid;
+    sbuf.write(kCallAtomic.packed, kCallAtomic.size);
+    pk.pack_array(1);
+    pk.pack_array(count);
+
+    MethodStats::Entry &stats = stats_.entry(kCallAtomic.name);
+    stats.add_bytes(sbuf.size() + calls.size());
+    // The calls are already packed, they follow the header in the same
+    // gather write without being copied.
+    enqueue(std::move(sbuf));
+    enqueue(std::move(calls));
+    if (handler)
+        add_pending(msgid, std::move(handler), stats, sent);
+    return msgid;
+}
+
+/// Messages are handed to the I/O thread right away, it writes whatever
+/// has piled up meanwhile with one gather write.
+void NvimRPC::enqueue(msgpack::sbuffer &&sbuf)
+{
+    pool_.note_size(sbuf.size());
+    bytes_sent_ += sbuf.size();
+    io_.send(std::move(sbuf));
+}
+
+msgpack::sbuffer NvimRPC::acquire_buffer()
+{
+    // Take back what the I/O thread has written meanwhile.
+    msgpack::sbuffer sbuf(0);
+    while (!pool_.full() && io_.take_recycled(sbuf)) {
+        pool_.release(std::move(sbuf));
+    }
+    return pool_.acquire();
+}
+
+msgpack::unpacked NvimRPC::receive(double timeout_sec, bool interruptible)
+{
+    msgpack::unpacked msg;
+    if (!io_.receive(msg, timeout_sec, interruptible))
+        throw boost::system::system_error(boost::asio::error::timed_out);
+    return msg;
+}
+
+void NvimRPC::wait(uint64_t msgid, double timeout_sec)
+{
+    while (pending_.count(msgid)) {
+        msgpack::unpacked msg = receive(timeout_sec);
+        if (!handle_response(msg))
+            inbox_.push_back(std::move(msg));
+    }
+}
+
+msgpack::unpacked NvimRPC::next_message(double timeout_sec)
+{
+    if (!inbox_.empty()) {
+        msgpack::unpacked msg = std::move(inbox_.front());
+        inbox_.pop_front();
+        return msg;
+    }
+    while (true) {
+        msgpack::unpacked msg = receive(timeout_sec, true);
+        if (!handle_response(msg))
+            return msg;
+    }
+}
+
+bool NvimRPC::try_next_message(msgpack::unpacked &msg)
+{
+    if (!inbox_.empty()) {
+        msg = std::move(inbox_.front());
+        inbox_.pop_front();
+        return true;
+    }
+    while (io_.try_receive(msg)) {
+        if (!handle_response(msg))
+            return true;
+    }
+    return false;
+}
+
+BatchBase::BatchBase(NvimRPC *rpc) :
+    rpc_(rpc),
+    body_(rpc->acquire_buffer())
+{
+}
+
+void BatchBase::send()
+{
+    if (empty())
+        return;
+    rpc_->send_atomic(std::move(body_), count_,
+        [](const msgpack::object &err, const msgpack::object &res) {
+            if (!err.is_nil()) {
+                LOG_WARN("nvim_call_atomic: %s", dump(err).c_str());
+            } else if (res.type == msgpack::type::ARRAY && res.via.array.size == 2
+                    && !res.via.array.ptr[1].is_nil()) {
+                // [index, type, message] of the call that failed
+                LOG_WARN("nvim_call_atomic: %s", dump(res.via.array.ptr[1]).c_str());
+            }
+        });
+    reset();
+}
+
+Future<BatchResult> BatchBase::future_send()
+{
+    auto slot = std::make_shared<detail::Slot<BatchResult>>();
+    uint64_t msgid = rpc_->send_atomic(std::move(body_), count_,
+        [slot](const msgpack::object &err, const msgpack::object &res) {
+            if (!err.is_nil()) {
+                LOG_WARN("nvim_call_atomic: %s", dump(err).c_str());
+                slot->failed = true;
+                slot->set_done();
+                return;
+            }
+            detail::fill(*slot, res, detail::decode_batch_result);
+        });
+    reset();
+    return Future<BatchResult>(rpc_, msgid, slot);
+}
+
+BatchResult BatchBase::execute()
+{
+    return future_send().get();
+}
+
+void detail::decode_batch_result(const msgpack::object &obj, BatchResult &res)
+{
+    // [results, error]
+    if (obj.type != msgpack::type::ARRAY || obj.via.array.size != 2)
+        throw msgpack::type_error();
+    // The message is freed once the handler returns, keep a deep copy.
+    res.zone = std::make_shared<msgpack::zone>();
+    res.results = msgpack::object(obj.via.array.ptr[0], *res.zone);
+    res.error = msgpack::object(obj.via.array.ptr[1], *res.zone);
+}
+
+void BatchBase::reset()
+{
+    body_ = rpc_->acquire_buffer();
+    count_ = 0;
+}
+
+} //namespace nvim
@@ -0,0 +1,134 @@
+#include "reactor.hpp"
+
+#ifdef NVIM_HAS_EPOLL
+
+#include <boost/system/system_error.hpp>
+#include <cerrno>
+#include <cstdint>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+namespace nvim {
+
+static void throw_errno(const char *what)
+{
+    throw boost::system::system_error(errno, boost::system::system_category(), what);
+}
+
+static void add_fd(int epfd, int fd, uint32_t events)
+{
+    epoll_event ev{};
+    ev.events = events;
+    ev.data.fd = fd;
+    if (epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &ev) < 0)
+        throw_errno("epoll_ctl");
+}
+
+Reactor::Reactor()
+{
+    epfd_ = epoll_create1(EPOLL_CLOEXEC);
+    if (epfd_ < 0)
+        throw_errno("epoll_create1");
+    eventfd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (eventfd_ < 0)
+        throw_errno("eventfd");
+    timerfd_ = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (timerfd_ < 0)
+        throw_errno("timerfd_create");
+
+    add_fd(epfd_, eventfd_, EPOLLIN);
+    add_fd(epfd_, timerfd_, EPOLLIN);
+}
+
+Reactor::~Reactor()
+{
+    close(timerfd_);
+    close(eventfd_);
+    close(epfd_);
+}
+
+void Reactor::watch(int rfd, int wfd)
+{
+    rfd_ = rfd;
+    wfd_ = wfd;
+    if (rfd == wfd) {
+        add_fd(epfd_, rfd, EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET);
+    } else {
+        add_fd(epfd_, rfd, EPOLLIN | EPOLLRDHUP | EPOLLET);
+        add_fd(epfd_, wfd, EPOLLOUT | EPOLLET);
+    }
+}
+
+void Reactor::unwatch()
+{
+    if (rfd_ < 0)
+        return;
+    epoll_ctl(epfd_, EPOLL_CTL_DEL, rfd_, nullptr);
+    if (wfd_ != rfd_)
+        epoll_ctl(epfd_, EPOLL_CTL_DEL, wfd_, nullptr);
+    rfd_ = wfd_ = -1;
+}
+
+void Reactor::wakeup()
+{
+    uint64_t one = 1;
+    // EAGAIN only when the counter is about to overflow, it is then
+    // readable anyway.
+    ssize_t n = write(eventfd_, &one, sizeof(one));
+    (void)n;
+}
+
+void Reactor::arm_timer(double timeout_sec)
+{
+    itimerspec spec{};
+    spec.it_value.tv_sec = time_t(timeout_sec);
+    spec.it_value.tv_nsec = long((timeout_sec - double(spec.it_value.tv_sec)) * 1e9);
+    if (spec.it_value.tv_sec == 0 && spec.it_value.tv_nsec == 0)
+        spec.it_value.tv_nsec = 1;  // zero would disarm
+    if (timerfd_settime(timerfd_, 0, &spec, nullptr) < 0)
+        throw_errno("timerfd_settime");
+}
+
+void Reactor::disarm_timer()
+{
+    itimerspec spec{};
+    timerfd_settime(timerfd_, 0, &spec, nullptr);
+}
+
+unsigned Reactor::wait()
+{
+    epoll_event evs[4];
+    int n;
+    do {
+        n = epoll_wait(epfd_, evs, 4, -1);
+    } while (n < 0 && errno == EINTR);
+    if (n < 0)
+        throw_errno("epoll_wait");
+
+    unsigned events = 0;
+    uint64_t count;
+    for (int i = 0; i < n; ++i) {
+        int fd = evs[i].data.fd;
+        if (fd == eventfd_) {
+            if (read(eventfd_, &count, sizeof(count)) > 0)
+                events |= kWakeup;
+        } else if (fd == timerfd_) {
+            // Nothing to read when the timer was re-armed meanwhile.
+            if (read(timerfd_, &count, sizeof(count)) > 0)
+                events |= kTimeout;
+        } else {
+            // Hang-ups and errors surface from the next read.
+            if (fd == rfd_ && (evs[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)))
+                events |= kReadable;
+            if (fd == wfd_ && (evs[i].events & (EPOLLOUT | EPOLLERR)))
+                events |= kWritable;
+        }
+    }
+    return events;
+}
+
+} //namespace nvim
+
+#endif // NVIM_HAS_EPOLL
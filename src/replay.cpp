@@ -0,0 +1,256 @@
+// tree-replay CAPTURE
+//
+// Plays nvim's side of a session recorded with TREE_CAPTURE=file against an
+// in-process server, as fast as it will go, then reports throughput and the
+// per-action latencies of the server (its _tree_stats).
+//
+// The server is not paced by the recorded timestamps but by its own output:
+// a recorded inbound frame is only sent once the server has written as many
+// frames as it had when the frame came in. Responses thus follow their
+// requests and notifications arrive in the same state as in the session,
+// as long as the server behaves the same (same directories on disk).
+#include "nvim.hpp"
+#include "app/eventloop.h"
+#include "capture.hpp"
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/asio/write.hpp>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <iostream>
+#include <limits>
+#include <locale>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+using std::cerr;
+using std::cout;
+using std::endl;
+using std::string;
+using boost::asio::local::stream_protocol;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// How long to wait for the server to catch up with the capture before
+// sending the next frame anyway.
+const double kGateTimeout = 2;
+const uint64_t kStatsMsgid = std::numeric_limits<uint32_t>::max();
+
+struct Frame {
+    string data;
+    size_t after;  // outbound frames written before this one came in
+};
+
+struct Session {
+    std::vector<Frame> frames;  // inbound
+    size_t outbound = 0;
+    size_t inbound_bytes = 0;
+    size_t outbound_bytes = 0;
+    uint64_t duration_us = 0;
+};
+
+Session load(const string &path)
+{
+    Session s;
+    msgpack::unpacker in, out;
+    msgpack::unpacked msg;
+    for (const nvim::CaptureRecord &r : nvim::read_capture(path)) {
+        s.duration_us = r.time_us;
+        msgpack::unpacker &u = r.dir == nvim::Direction::kInbound ? in : out;
+        u.reserve_buffer(r.data.size());
+        std::copy(r.data.begin(), r.data.end(), u.buffer());
+        u.buffer_consumed(r.data.size());
+        while (u.next(msg)) {
+            if (r.dir == nvim::Direction::kOutbound) {
+                ++s.outbound;
+                continue;
+            }
+            msgpack::sbuffer sbuf;
+            msgpack::pack(sbuf, msg.get());
+            s.inbound_bytes += sbuf.size();
+            s.frames.push_back(Frame{string(sbuf.data(), sbuf.size()), s.outbound});
+        }
+        if (r.dir == nvim::Direction::kOutbound)
+            s.outbound_bytes += r.data.size();
+    }
+    return s;
+}
+
+/// Reads the server's output: counts its frames and keeps the reply to
+/// the final _tree_stats request.
+class Peer {
+public:
+    explicit Peer(stream_protocol::socket &socket) : socket_(socket) {}
+
+    void run() {
+        msgpack::unpacker u;
+        msgpack::unpacked msg;
+        boost::system::error_code ec;
+        while (true) {
+            u.reserve_buffer(64 * 1024);
+            size_t n = socket_.read_some(boost::asio::buffer(u.buffer(), u.buffer_capacity()), ec);
+            if (ec)
+                break;
+            u.buffer_consumed(n);
+            std::lock_guard<std::mutex> lock(mutex_);
+            bytes_ += n;
+            while (u.next(msg)) {
+                ++frames_;
+                const msgpack::object &obj = msg.get();
+                if (obj.type == msgpack::type::ARRAY && obj.via.array.size == 4
+                        && obj.via.array.ptr[0].via.u64 == 1
+                        && obj.via.array.ptr[1].via.u64 == kStatsMsgid)
+                    stats_ = std::move(msg);
+                changed_.notify_all();
+            }
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+        changed_.notify_all();
+    }
+
+    /// False when the server did not get there in time.
+    bool wait_frames(size_t n, double timeout_sec) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return changed_.wait_for(lock, std::chrono::duration<double>(timeout_sec),
+                [&] { return frames_ >= n || closed_; }) && frames_ >= n;
+    }
+
+    bool wait_stats(double timeout_sec) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return changed_.wait_for(lock, std::chrono::duration<double>(timeout_sec),
+                [&] { return stats_.get().type != msgpack::type::NIL || closed_; })
+            && stats_.get().type != msgpack::type::NIL;
+    }
+
+    size_t frames() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return frames_;
+    }
+
+    size_t bytes() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return bytes_;
+    }
+
+    const msgpack::object &stats() const { return stats_.get(); }
+
+private:
+    stream_protocol::socket &socket_;
+    std::mutex mutex_;
+    std::condition_variable changed_;
+    size_t frames_ = 0;
+    size_t bytes_ = 0;
+    bool closed_ = false;
+    msgpack::unpacked stats_;
+};
+
+void print_table(const char *title, const nvim::ObjectRef &methods)
+{
+    if (!methods.is_map())
+        return;
+    printf("\n%-28s %8s %10s %10s %10s %12s\n", title, "count", "avg_us", "p99_us", "max_us", "bytes");
+    methods.for_each_pair([](const nvim::ObjectRef &name, const nvim::ObjectRef &e) {
+        // Upper bound of the bucket holding the 99th percentile.
+        int64_t count = 0;
+        nvim::ObjectRef histogram = e.get("latency_us");
+        for (uint32_t i = 0; i < histogram.size(); ++i)
+            count += histogram.at(i).at(1).as_int();
+        int64_t seen = 0, p99 = 0;
+        for (uint32_t i = 0; i < histogram.size(); ++i) {
+            seen += histogram.at(i).at(1).as_int();
+            p99 = histogram.at(i).at(0).as_int();
+            if (seen * 100 >= count * 99)
+                break;
+        }
+        string key = name.as_string();
+        printf("%-28s %8lld %10lld %10lld %10lld %12lld\n", key.c_str(),
+               (long long)e.get("count").as_int(), (long long)e.get("avg_us").as_int(),
+               (long long)p99, (long long)e.get("max_us").as_int(),
+               (long long)e.get("bytes").as_int());
+    });
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2) {
+        cerr << "usage: " << argv[0] << " CAPTURE" << endl;
+        return 2;
+    }
+    std::locale::global(std::locale(""));
+    Session session = load(argv[1]);
+    cout << "capture: " << session.frames.size() << " frames in, "
+         << session.outbound << " frames out, "
+         << session.duration_us / 1000 << " ms" << endl;
+
+    // The server connects to us as it would to nvim's servername.
+    string path = "/tmp/tree-replay-" + std::to_string(getpid()) + ".sock";
+    boost::asio::io_service io_service;
+    ::unlink(path.c_str());
+    stream_protocol::acceptor acceptor(io_service, stream_protocol::endpoint(path));
+    std::thread server([&path] {
+        nvim::Nvim nvim;
+        nvim.connect_pipe(path);
+        tree::eventloop(nvim);
+    });
+    stream_protocol::socket socket(io_service);
+    acceptor.accept(socket);
+    ::unlink(path.c_str());
+
+    Peer peer(socket);
+    std::thread reader([&peer] { peer.run(); });
+
+    size_t late = 0;
+    Clock::time_point start = Clock::now();
+    for (const Frame &f : session.frames) {
+        if (!peer.wait_frames(f.after, kGateTimeout))
+            ++late;
+        boost::asio::write(socket, boost::asio::buffer(f.data));
+    }
+    if (!peer.wait_frames(session.outbound, kGateTimeout))
+        ++late;
+    double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+    // [type(0), msgid, method, params]
+    msgpack::sbuffer request;
+    msgpack::packer<msgpack::sbuffer> pk(&request);
+    pk.pack_array(4);
+    pk.pack_uint64(0);
+    pk.pack_uint64(kStatsMsgid);
+    pk.pack(string("_tree_stats"));
+    pk.pack_array(0);
+    boost::asio::write(socket, boost::asio::buffer(request.data(), request.size()));
+    bool have_stats = peer.wait_stats(5);
+
+    printf("\nreplay: %.1f ms (recorded %.1f ms)\n", elapsed * 1000, session.duration_us / 1000.0);
+    printf("in:  %zu frames, %zu bytes, %.0f frames/s\n", session.frames.size(),
+           session.inbound_bytes, session.frames.size() / elapsed);
+    printf("out: %zu frames, %zu bytes, %.0f frames/s (recorded %zu frames, %zu bytes)\n",
+           peer.frames(), peer.bytes(), peer.frames() / elapsed,
+           session.outbound, session.outbound_bytes);
+    if (late)
+        printf("%zu frames sent before the server caught up, the session diverged\n", late);
+    if (have_stats) {
+        nvim::ObjectRef stats = nvim::ObjectRef(peer.stats()).at(3);
+        print_table("actions", stats.get("actions"));
+        print_table("requests", stats.get("requests"));
+        print_table("outgoing", stats.get("outgoing"));
+    } else {
+        printf("no reply to _tree_stats\n");
+    }
+
+    // eof ends the eventloop.
+    boost::system::error_code ec;
+    socket.shutdown(stream_protocol::socket::shutdown_both, ec);
+    reader.join();
+    server.join();
+    return 0;
+}
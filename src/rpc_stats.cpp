@@ -0,0 +1,40 @@
+#include "rpc_stats.hpp"
+
+namespace nvim {
+
+const size_t MethodStats::kBuckets;
+
+void MethodStats::Entry::add_latency(Clock::duration elapsed)
+{
+    uint64_t us = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+    ++timed;
+    total_us += us;
+    if (us > max_us)
+        max_us = us;
+
+    size_t i = 0;
+    while (i + 1 < kBuckets && us >= bucket_bound_us(i))
+        ++i;
+    ++buckets[i];
+}
+
+uint64_t MethodStats::Entry::percentile_us(double p) const
+{
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBuckets; ++i) {
+        seen += buckets[i];
+        if (seen > 0 && seen >= p * timed)
+            return i + 1 < kBuckets ? bucket_bound_us(i) : max_us;
+    }
+    return 0;
+}
+
+MethodStats::Entry &MethodStats::entry(boost::string_ref name)
+{
+    auto it = entries_.find(name);
+    if (it == entries_.end())
+        it = entries_.emplace(name.to_string(), Entry()).first;
+    return it->second;
+}
+
+} //namespace nvim
@@ -1,44 +1,88 @@
 #include "socket.hpp"
 
-#include <boost/lambda/bind.hpp>
-// #include <boost/lambda/lambda.hpp>
 #include <boost/asio/write.hpp>
-#include <boost/asio/read.hpp>
-#include <boost/asio/deadline_timer.hpp>
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/asio/local/stream_protocol.hpp>
+#include <algorithm>
+#include "reactor.hpp"
+#ifdef BOOST_ASIO_HAS_POSIX_STREAM_DESCRIPTOR
+#include <unistd.h>
+#endif
+#ifdef NVIM_HAS_EPOLL
+#include <sys/socket.h>
+#endif
 
 #define BOOST_VARIANT_USE_RELAXED_GET_BY_DEFAULT
 
-using boost::asio::deadline_timer;
 using boost::asio::ip::tcp;
-using boost::lambda::bind;
-// using boost::lambda::var;
-// using boost::lambda::_1;
-// using boost::lambda::_2;
 
 namespace nvim {
 
+namespace {
+
+using Endpoint = boost::asio::generic::stream_protocol::endpoint;
+
+// Connect, giving up after timeout_sec. The connect is started non-blocking
+// and a Reactor waits for the socket to turn writable or for the deadline;
+// without epoll it blocks.
+void connect_until(boost::asio::generic::stream_protocol::socket &socket,
+                   const Endpoint &ep, double timeout_sec,
+                   boost::system::error_code &ec)
+{
+#ifdef NVIM_HAS_EPOLL
+    if (!socket.is_open())
+        socket.open(ep.protocol(), ec);
+    if (!ec)
+        socket.non_blocking(true, ec);
+    if (ec)
+        return;
+    socket.connect(ep, ec);
+    if (ec == boost::asio::error::in_progress || ec == boost::asio::error::would_block) {
+        const int fd = socket.native_handle();
+        Reactor reactor;
+        reactor.watch(fd, fd);
+        reactor.arm_timer(timeout_sec);
+        unsigned events;
+        do {
+            events = reactor.wait();
+        } while (!(events & (Reactor::kWritable | Reactor::kTimeout)));
+        reactor.unwatch();
+
+        if (events & Reactor::kWritable) {
+            int err = 0;
+            socklen_t len = sizeof(err);
+            if (::getsockopt(fd, SOL_SOCKET, SO_ERROR, &err, &len) != 0)
+                err = errno;
+            ec = boost::system::error_code(err, boost::system::system_category());
+        } else {
+            ec = boost::asio::error::timed_out;
+        }
+    }
+    // IoThread decides later how the socket is driven.
+    boost::system::error_code ignored;
+    socket.non_blocking(false, ignored);
+#else
+    (void)timeout_sec;
+    socket.connect(ep, ec);
+#endif
+}
+
+} // namespace
+
+const size_t Socket::kMinReadSize;
+const size_t Socket::kMaxReadSize;
+
 void Socket::connect_tcp(const std::string& host,
                      const std::string& service, double timeout_sec)
 {
     tcp::resolver::query query(host, service);
     tcp::resolver::iterator iter = tcp::resolver(io_service_).resolve(query);
 
-    deadline_.expires_from_now(boost::posix_time::seconds(long(timeout_sec)));
-
     boost::system::error_code ec;
 
     for (; iter != tcp::resolver::iterator(); ++iter) {
         socket_.close();
-        ec = boost::asio::error::would_block;
-        // socket_.async_connect(iter->endpoint(), var(ec) = _1);
-        socket_.async_connect(iter->endpoint(),
-                        [&ec](boost::system::error_code e){
-                            ec = e;
-                        });
-
-        do io_service_.run_one(); while (ec == boost::asio::error::would_block);
+        connect_until(socket_, Endpoint(iter->endpoint()), timeout_sec, ec);
         if (!ec && socket_.is_open()) return;
     }
 
@@ -50,84 +94,198 @@ void Socket::connect_pipe(const std::string& name, double timeout_sec)
 {
 #ifdef BOOST_ASIO_HAS_LOCAL_SOCKETS
     boost::asio::local::stream_protocol::endpoint ep(name);
-    socket_.connect(ep);
+    boost::system::error_code ec;
+    connect_until(socket_, Endpoint(ep), timeout_sec, ec);
+    if (ec)
+        throw boost::system::system_error(ec);
+#else
+    (void)timeout_sec;
+    throw boost::system::system_error(boost::asio::error::operation_not_supported);
 #endif
 }
-size_t Socket::read(char *rbuf, size_t capacity, double timeout_sec) {
-    deadline_.expires_from_now(boost::posix_time::seconds(long(timeout_sec)));
-    boost::system::error_code ec = boost::asio::error::would_block;
-    size_t rlen;
-    async_read(socket_, boost::asio::buffer(rbuf, capacity),
-        boost::asio::transfer_at_least(1),
-        [&ec, &rlen](boost::system::error_code e, size_t s) {ec = e; rlen = s;});
 
-    // Block until the asynchronous operation has completed.
-    do io_service_.run_one(); while (ec == boost::asio::error::would_block);
-    if (ec) throw boost::system::system_error(ec);
+void Socket::connect_fd(int fd)
+{
+#ifdef BOOST_ASIO_HAS_LOCAL_SOCKETS
+    socket_.assign(boost::asio::generic::stream_protocol(AF_UNIX, SOCK_STREAM), fd);
+#else
+    throw boost::system::system_error(boost::asio::error::operation_not_supported);
+#endif
+}
 
-    return rlen;
+void Socket::connect_stdio()
+{
+#ifdef BOOST_ASIO_HAS_POSIX_STREAM_DESCRIPTOR
+    // Own duplicates, fd 0 and 1 stay valid for the rest of the process.
+    int in = ::dup(STDIN_FILENO);
+    int out = ::dup(STDOUT_FILENO);
+    if (in < 0 || out < 0 || ::dup2(STDERR_FILENO, STDOUT_FILENO) < 0)
+        throw boost::system::system_error(errno, boost::system::system_category(), "dup");
+    stdin_.assign(in);
+    stdout_.assign(out);
+    stdio_ = true;
+#else
+    throw boost::system::system_error(boost::asio::error::operation_not_supported);
+#endif
 }
-/// 能够根据msgpack message的长度, 动态增加缓冲区
-msgpack::unpacked Socket::read2(double timeout_sec)
+
+int Socket::read_handle()
 {
-    size_t rlen = 0;
-    msgpack::unpacker unp;
+#ifdef BOOST_ASIO_HAS_POSIX_STREAM_DESCRIPTOR
+    if (stdio_)
+        return stdin_.native_handle();
+#endif
+    return socket_.native_handle();
+}
 
-    do {
-        deadline_.expires_from_now(boost::posix_time::seconds(long(timeout_sec)));
-        boost::system::error_code ec = boost::asio::error::would_block;
-        if (unp.buffer_capacity() == 0) {
-            std::cout << "-----reserve_buffer-----" << std::endl;
-            unp.reserve_buffer(8192);
-        }
+int Socket::write_handle()
+{
+#ifdef BOOST_ASIO_HAS_POSIX_STREAM_DESCRIPTOR
+    if (stdio_)
+        return stdout_.native_handle();
+#endif
+    return socket_.native_handle();
+}
 
-        // rlen = socket_.read_some(boost::asio::buffer(unp.buffer(), unp.buffer_capacity()));
-        // TODO: 异步读取超时导致套接字关闭
-        async_read(
-            socket_,
-            boost::asio::buffer(unp.buffer(), unp.buffer_capacity()),
-            boost::asio::transfer_at_least(1),
-            [&ec, &rlen](boost::system::error_code e, size_t s) {
-                ec = e;
-                rlen = s;
-            });
-
-        do io_service_.run_one(); while (ec == boost::asio::error::would_block);
-        if (ec) throw boost::system::system_error(ec);
-
-        if (rlen > 0) {
-            msgpack::unpacked result;
-            unp.buffer_consumed(rlen);
-            if (unp.next(result)) {
-                return result;
-            }
+void Socket::set_non_blocking()
+{
+#ifdef BOOST_ASIO_HAS_POSIX_STREAM_DESCRIPTOR
+    if (stdio_) {
+        stdin_.non_blocking(true);
+        stdout_.non_blocking(true);
+        return;
+    }
+#endif
+    socket_.non_blocking(true);
+}
+
+void Socket::reserve_read_buffer()
+{
+    if (unpacker_.buffer_capacity() < read_hint_) {
+        unpacker_.reserve_buffer(read_hint_);
+    }
+}
+
+boost::system::error_code Socket::read_messages(const MessageHandler &on_message)
+{
+    boost::system::error_code ec;
+    msgpack::unpacked msg;
+    while (true) {
+        // Messages completed by an earlier read come first.
+        while (unpacker_.next(msg)) {
+            on_message(std::move(msg));
         }
-    } while (rlen > 0);
+        reserve_read_buffer();
+        size_t capacity = unpacker_.buffer_capacity();
+        auto buf = boost::asio::buffer(unpacker_.buffer(), capacity);
+        size_t rlen;
+#ifdef BOOST_ASIO_HAS_POSIX_STREAM_DESCRIPTOR
+        if (stdio_)
+            rlen = stdin_.read_some(buf, ec);
+        else
+#endif
+            rlen = socket_.read_some(buf, ec);
+        if (ec)
+            return ec;
+        if (capture_)
+            capture_->write(Direction::kInbound, unpacker_.buffer(), rlen);
+        unpacker_.buffer_consumed(rlen);
+        update_read_hint(rlen, capacity);
+    }
 }
 
-void Socket::write(char *sbuf, size_t size, double timeout_sec) {
-    deadline_.expires_from_now(boost::posix_time::seconds(long(timeout_sec)));
-    boost::system::error_code ec = boost::asio::error::would_block;
-    // boost::asio::async_write(socket_, boost::asio::buffer(sbuf, size), var(ec) = _1);
-    boost::asio::async_write(socket_, boost::asio::buffer(sbuf, size),
-                [&ec](boost::system::error_code e, size_t s){
-                    ec = e;
-                });
+size_t Socket::write_some(const std::vector<boost::asio::const_buffer> &bufs,
+                          boost::system::error_code &ec)
+{
+    size_t n;
+#ifdef BOOST_ASIO_HAS_POSIX_STREAM_DESCRIPTOR
+    if (stdio_)
+        n = stdout_.write_some(bufs, ec);
+    else
+#endif
+        n = socket_.write_some(bufs, ec);
+    if (capture_ && n > 0)
+        capture_->write(Direction::kOutbound, bufs, n);
+    return n;
+}
 
-    do io_service_.run_one(); while (ec == boost::asio::error::would_block);
+void Socket::async_read_messages(MessageHandler on_message, ErrorHandler on_error)
+{
+    on_message_ = std::move(on_message);
+    on_read_error_ = std::move(on_error);
+    start_read();
+}
 
-    if (ec) throw boost::system::system_error(ec);
+void Socket::start_read()
+{
+    msgpack::unpacked msg;
+    while (unpacker_.next(msg)) {
+        on_message_(std::move(msg));
+    }
+    reserve_read_buffer();
+    size_t capacity = unpacker_.buffer_capacity();
+    auto on_read = [this, capacity](const boost::system::error_code &ec, size_t rlen) {
+            if (ec) {
+                on_read_error_(ec);
+                return;
+            }
+            if (capture_)
+                capture_->write(Direction::kInbound, unpacker_.buffer(), rlen);
+            unpacker_.buffer_consumed(rlen);
+            update_read_hint(rlen, capacity);
+            start_read();
+        };
+    auto buf = boost::asio::buffer(unpacker_.buffer(), capacity);
+#ifdef BOOST_ASIO_HAS_POSIX_STREAM_DESCRIPTOR
+    if (stdio_) {
+        stdin_.async_read_some(buf, on_read);
+        return;
+    }
+#endif
+    socket_.async_read_some(buf, on_read);
 }
 
-void Socket::check_deadline() {
-    if (deadline_.expires_at() <= deadline_timer::traits_type::now()) {
-        // socket_.close();
-        socket_.cancel();
-        deadline_.expires_at(boost::posix_time::pos_infin);
+/// Size the next read from recent traffic: grow quickly while reads fill
+/// the whole buffer (a burst of replies/notifications), shrink slowly back
+/// towards the typical read size when traffic calms down (a moving average
+/// where each read weighs a quarter).
+void Socket::update_read_hint(size_t rlen, size_t capacity)
+{
+    if (rlen >= capacity) {
+        read_hint_ = std::min(read_hint_ * 2, kMaxReadSize);
+    } else {
+        read_hint_ = std::max((read_hint_ * 3 + rlen) / 4, kMinReadSize);
     }
+}
 
-    deadline_.async_wait(bind(&Socket::check_deadline, this));
+void Socket::async_write(const std::vector<boost::asio::const_buffer> &bufs, ErrorHandler on_done)
+{
+    // The data stays alive until on_done, the vector of buffers may not.
+    std::vector<boost::asio::const_buffer> captured;
+    if (capture_)
+        captured = bufs;
+    auto on_write = [this, captured, on_done](boost::system::error_code e, size_t s){
+                    if (capture_ && s > 0)
+                        capture_->write(Direction::kOutbound, captured, s);
+                    on_done(e);
+                };
+#ifdef BOOST_ASIO_HAS_POSIX_STREAM_DESCRIPTOR
+    if (stdio_) {
+        boost::asio::async_write(stdout_, bufs, on_write);
+        return;
+    }
+#endif
+    boost::asio::async_write(socket_, bufs, on_write);
 }
 
-} //namespace nvim
+void Socket::close()
+{
+    boost::system::error_code ec;
+    socket_.close(ec);
+#ifdef BOOST_ASIO_HAS_POSIX_STREAM_DESCRIPTOR
+    stdin_.close(ec);
+    stdout_.close(ec);
+#endif
+}
 
+} //namespace nvim
@@ -0,0 +1,267 @@
+// tree-test
+//
+// Behaviour checks, no nvim needed. The parts with a format of their own
+// (SpscRing, the generated dispatch tables, the compact action context,
+// session snapshots) are checked directly. Then a server is run against
+// MockNvim on a scratch directory: _tree_start, opening and closing a
+// directory and redraws, each checked on the buffer lines and highlights
+// the mock ends up with.
+#include "nvim.hpp"
+#include "app/eventloop.h"
+#include "app/column.h"
+#include "app/session.h"
+#include "dispatch.hpp"
+#include "mock_nvim.hpp"
+#include "spsc_ring.hpp"
+#include <boost/filesystem.hpp>
+#include <cstdio>
+#include <fstream>
+#include <locale>
+#include <string>
+#include <thread>
+#include <vector>
+
+using std::string;
+using std::vector;
+namespace fs = boost::filesystem;
+
+namespace {
+
+int failures = 0;
+
+#define CHECK(cond) \
+do { \
+    if (!(cond)) { \
+        std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+        ++failures; \
+    } \
+} while (0)
+
+void touch(const fs::path &p)
+{
+    std::ofstream(p.string()) << p.filename().string() << '\n';
+}
+
+void test_spsc_ring()
+{
+    nvim::SpscRing<string> ring(3);
+    CHECK(ring.capacity() == 4);
+    CHECK(ring.empty());
+    for (int i = 0; i < 4; ++i)
+        CHECK(ring.push(std::to_string(i)));
+    CHECK(!ring.push("full"));
+
+    string s;
+    for (int i = 0; i < 4; ++i) {
+        CHECK(ring.pop(s));
+        CHECK(s == std::to_string(i));
+    }
+    CHECK(!ring.pop(s));
+    CHECK(ring.empty());
+}
+
+void test_dispatch_tables()
+{
+    using namespace tree::rpc;
+    CHECK(find_request("_tree_start") == Request::kTreeStart);
+    CHECK(find_request("_tree_do_action") == Request::kTreeDoAction);
+    CHECK(find_request("_tree_star") == Request::kUnknown);
+    CHECK(find_notification("_tree_async_action") == Notification::kTreeAsyncAction);
+    CHECK(find_function("on_detach") == Function::kOnDetach);
+    CHECK(find_action("open_or_close_tree") == Action::kOpenOrCloseTree);
+    CHECK(find_action("redraw") == Action::kRedraw);
+    CHECK(find_action("") == Action::kUnknown);
+    CHECK(find_action("redraw ") == Action::kUnknown);
+}
+
+msgpack::unpacked pack(const nvim::Object &obj)
+{
+    msgpack::sbuffer sbuf;
+    msgpack::pack(sbuf, obj);
+    return msgpack::unpack(sbuf.data(), sbuf.size());
+}
+
+void test_context()
+{
+    // [cursor, prev_bufnr, prev_winid, visual_start, visual_end]
+    msgpack::unpacked compact = pack(nvim::Array{7, 3, 1001, 5, 9});
+    tree::Context ctx;
+    ctx.update(compact.get());
+    CHECK(ctx.cursor == 7);
+    CHECK(ctx.prev_bufnr == 3);
+    CHECK(ctx.prev_winid == 1001);
+    CHECK(ctx.visual_start == 5);
+    CHECK(ctx.visual_end == 9);
+
+    // The map form updates only what it has.
+    msgpack::unpacked map = pack(nvim::Dictionary{{"cursor", 2}});
+    ctx.update(map.get());
+    CHECK(ctx.cursor == 2);
+    CHECK(ctx.prev_bufnr == 3);
+}
+
+void test_snapshot(const fs::path &tmp)
+{
+    using tree::Snapshot;
+    const fs::path root = tmp / "snap";
+    fs::create_directories(root / "sub");
+    touch(root / "a");
+    touch(root / "sub" / "b");
+    tree::dir_cache.list(root);
+    tree::dir_cache.list(root / "sub");
+
+    const string file = (tmp / "session").string();
+    CHECK(Snapshot::save(file, root.string(), {(root / "sub").string()},
+                         {{root.string(), 3}}, {"snap/", "  sub/", "    b", "  a"}));
+
+    auto snap = Snapshot::load(file, root.string());
+    CHECK(snap);
+    if (snap) {
+        CHECK(snap->root == root.string());
+        CHECK(snap->expanded.size() == 1 && snap->expanded[0] == (root / "sub").string());
+        CHECK(snap->cursors.size() == 1 && snap->cursors[0].second == 3);
+        CHECK(snap->lines.size() == 4 && snap->lines[3] == "  a");
+    }
+    CHECK(!Snapshot::load(file, (tmp / "other").string()));
+
+    // Cut short: the header size no longer matches.
+    fs::resize_file(file, fs::file_size(file) - 1);
+    CHECK(!Snapshot::load(file, root.string()));
+    CHECK(!Snapshot::load((tmp / "missing").string(), root.string()));
+}
+
+/// Every line carries the filename highlight, a directory's or a file's.
+bool highlighted(const nvim::MockNvim::Buffer &b)
+{
+    const string prefix = "tree_" + std::to_string(tree::FILENAME) + "_";
+    for (size_t i = 0; i < b.lines.size(); ++i) {
+        bool found = false;
+        for (const auto &h : b.highlights) {
+            if (h.line == int64_t(i) && h.group.compare(0, prefix.size(), prefix) == 0)
+                found = true;
+            if (h.line < 0 || h.line >= int64_t(b.lines.size()))
+                return false;
+        }
+        if (!found)
+            return false;
+    }
+    return true;
+}
+
+bool contains(const string &line, const string &s)
+{
+    return line.find(s) != string::npos;
+}
+
+struct Client {
+    nvim::MockNvim &mock;
+    int64_t bufnr;
+
+    void action(const string &name, int64_t line) {
+        // _tree_do_action [action, args, [cursor, prev_bufnr, prev_winid, visual_start, visual_end]]
+        mock.request("_tree_do_action", nvim::Array{name, nvim::Array{},
+                     nvim::Array{line, bufnr, 1000, line, line}});
+    }
+
+    nvim::MockNvim::Buffer buffer() const {
+        return mock.state().buffers[bufnr];
+    }
+};
+
+void test_server(const fs::path &tmp)
+{
+    const fs::path root = tmp / "root";
+    fs::create_directories(root / "dir");
+    touch(root / "dir" / "inner.txt");
+    touch(root / "file.txt");
+
+    string path = (tmp / "mock.sock").string();
+    nvim::MockNvim mock(path);
+    std::thread server([&path] {
+        nvim::Nvim nvim;
+        nvim.connect_pipe(path);
+        tree::eventloop(nvim);
+    });
+    mock.accept();
+
+    mock.request("_tree_start", nvim::Array{nvim::Array{root.string()},
+                 nvim::Dictionary{{"columns", "mark:indent:icon:filename"}}});
+    bool painted = mock.wait([](const nvim::MockNvim::State &s) {
+        auto it = s.buffers.find(s.last_created);
+        return it != s.buffers.end() && it->second.lines.size() == 3;
+    }, 10);
+    CHECK(painted);
+    if (!painted) {
+        mock.close();
+        server.join();
+        return;
+    }
+
+    Client c{mock, mock.state().last_created};
+    nvim::MockNvim::Buffer b = c.buffer();
+    CHECK(b.name == "Tree-0");
+    // Root, then directories before files.
+    CHECK(contains(b.lines[0], "root"));
+    CHECK(contains(b.lines[1], "dir"));
+    CHECK(contains(b.lines[2], "file.txt"));
+    CHECK(highlighted(b));
+
+    c.action("open_or_close_tree", 2);
+    b = c.buffer();
+    CHECK(b.lines.size() == 4);
+    if (b.lines.size() == 4) {
+        CHECK(contains(b.lines[2], "inner.txt"));
+        CHECK(contains(b.lines[3], "file.txt"));
+    }
+    CHECK(highlighted(b));
+
+    c.action("open_or_close_tree", 2);
+    b = c.buffer();
+    CHECK(b.lines.size() == 3);
+    CHECK(highlighted(b));
+
+    // A redraw picks up what changed on disk.
+    const vector<string> before = b.lines;
+    c.action("redraw", 1);
+    b = c.buffer();
+    CHECK(b.lines == before);
+    CHECK(highlighted(b));
+
+    touch(root / "new.txt");
+    c.action("redraw", 1);
+    b = c.buffer();
+    CHECK(b.lines.size() == 4);
+    if (b.lines.size() == 4)
+        CHECK(contains(b.lines[3], "new.txt"));
+    CHECK(highlighted(b));
+
+    // Unknown actions are refused, the tree is left alone.
+    c.action("no_such_action", 1);
+    CHECK(c.buffer().lines == b.lines);
+
+    mock.close();
+    server.join();
+}
+
+} // namespace
+
+int main()
+{
+    std::locale::global(std::locale(""));
+    const fs::path tmp = fs::temp_directory_path() / fs::unique_path("tree-test-%%%%%%%%");
+    fs::create_directories(tmp);
+
+    test_spsc_ring();
+    test_dispatch_tables();
+    test_context();
+    test_snapshot(tmp);
+    test_server(tmp);
+
+    fs::remove_all(tmp);
+    if (failures) {
+        std::fprintf(stderr, "%d checks failed\n", failures);
+        return 1;
+    }
+    std::printf("all checks passed\n");
+    return 0;
+}
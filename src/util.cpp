@@ -1,5 +1,6 @@
 #include "nvim.hpp"
 #include "util.h"
+#include <sstream>
 
 std::string type_name(const nvim::Object &obj)
 {
@@ -20,3 +21,10 @@ std::string type_name(const nvim::Object &obj)
     else if (obj.is_uint64_t()) s = "uint64_t";
     return s;
 }
+
+std::string dump(const msgpack::object &obj)
+{
+    std::ostringstream os;
+    os << obj;
+    return os.str();
+}
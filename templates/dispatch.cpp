@@ -0,0 +1,86 @@
+// Auto generated by gen_dispatch.py from tree_rpc.json
+#include "dispatch.hpp"
+#include <string>
+
+namespace tree {
+namespace rpc {
+
+namespace {
+
+[[noreturn]] void bad(const char *where, const char *name, const char *expected) {
+    throw BadArgs(std::string(where) + ": " + name + " must be " + expected);
+}
+
+const msgpack::object *tuple(const nvim::ObjectRef &v, uint32_t n, const char *where) {
+    if (!v.is_array() || v.size() < n)
+        throw BadArgs(std::string(where) + ": expected an array of " + std::to_string(n));
+    return v.object().via.array.ptr;
+}
+
+void get_string(const nvim::ObjectRef &v, boost::string_ref &res, const char *where, const char *name) {
+    if (!v.is_string())
+        bad(where, name, "a String");
+    res = v.as_string_ref();
+}
+
+void get_integer(const nvim::ObjectRef &v, int64_t &res, const char *where, const char *name) {
+    if (v.type() != msgpack::type::POSITIVE_INTEGER && v.type() != msgpack::type::NEGATIVE_INTEGER &&
+            v.type() != msgpack::type::EXT)
+        bad(where, name, "an Integer");
+    res = v.as_int();
+}
+
+void get_boolean(const nvim::ObjectRef &v, bool &res, const char *where, const char *name) {
+    if (v.type() != msgpack::type::BOOLEAN)
+        bad(where, name, "a Boolean");
+    res = v.as_bool();
+}
+
+void get_array(const nvim::ObjectRef &v, nvim::ObjectRef &res, const char *where, const char *name) {
+    if (!v.is_array())
+        bad(where, name, "an Array");
+    res = v;
+}
+
+void get_dictionary(const nvim::ObjectRef &v, nvim::ObjectRef &res, const char *where, const char *name) {
+    if (!v.is_map())
+        bad(where, name, "a Dictionary");
+    res = v;
+}
+
+void get_context(const nvim::ObjectRef &v, nvim::ObjectRef &res, const char *where, const char *name) {
+    if (!v.is_array() && !v.is_map())
+        bad(where, name, "an Array or a Dictionary");
+    res = v;
+}
+
+void get_object(const nvim::ObjectRef &v, nvim::ObjectRef &res, const char *, const char *) {
+    res = v;
+}
+{% for t in tables %}
+const boost::string_ref k{{t.kind}}Names[] = {
+{%- for n in t.names %}
+    "{{n.name}}",
+{%- endfor %}
+};
+const int8_t k{{t.kind}}Slots[] = {
+    {% for i in t.slots %}{{i}},{% if not loop.last %} {% endif %}{% endfor %}
+};
+{% endfor %}
+} // namespace
+{% for t in tables %}
+{{t.kind}} find_{{t.kind|lower}}(boost::string_ref name) {
+    const uint32_t mask = sizeof(k{{t.kind}}Slots) - 1;
+    int i = k{{t.kind}}Slots[hash(name, {{t.seed}}u) & mask];
+    return i >= 0 && k{{t.kind}}Names[i] == name ? static_cast<{{t.kind}}>(i) : {{t.kind}}::kUnknown;
+}
+{% endfor %}
+{%- for s in structs %}
+{{s.struct}}::{{s.struct}}(const nvim::ObjectRef &msg) {
+{%- for line in s.decode %}
+    {{line}}
+{%- endfor %}
+}
+{% endfor %}
+} //namespace rpc
+} //namespace tree
@@ -0,0 +1,63 @@
+// Auto generated by gen_dispatch.py from tree_rpc.json
+
+#ifndef NEOVIM_CPP__DISPATCH_HPP
+#define NEOVIM_CPP__DISPATCH_HPP
+
+#include <cstdint>
+#include <stdexcept>
+#include <boost/utility/string_ref.hpp>
+
+#include "object_ref.hpp"
+
+namespace tree {
+namespace rpc {
+
+/// Thrown by the decoders, what() names the message and the argument.
+class BadArgs : public std::invalid_argument {
+public:
+    using std::invalid_argument::invalid_argument;
+};
+
+/// FNV-1a, the tables below are perfect hashes of it.
+inline uint32_t hash(boost::string_ref s, uint32_t seed) {
+    uint32_t h = 2166136261u ^ seed;
+    for (char c : s) {
+        h ^= static_cast<unsigned char>(c);
+        h *= 16777619u;
+    }
+    return h;
+}
+{% for t in tables %}
+enum class {{t.kind}} {
+{%- for n in t.names %}
+    {{n.const_name}},
+{%- endfor %}
+    kUnknown
+};
+/// kUnknown if there is no such name, no allocation either way.
+{{t.kind}} find_{{t.kind|lower}}(boost::string_ref name);
+{% endfor %}
+// X(id, member) of every Action, member being the Tree method running it.
+#define TREE_ACTIONS(X) \
+{%- for a in actions %}
+    X({{a.const_name}}, {{a.method}}){% if not loop.last %} \{% endif %}
+{%- endfor %}
+
+// Arguments, views into the received message. The constructors decode
+// them in one pass and throw BadArgs on a wrong count or type.
+{% for s in structs %}
+// {{s.name}} {{s.signature}}
+{%- for line in s.doc %}
+// {{line}}
+{%- endfor %}
+struct {{s.struct}} {
+    explicit {{s.struct}}(const nvim::ObjectRef &msg);
+{%- for line in s.members %}
+{{line}}
+{%- endfor %}
+};
+{% endfor %}
+} //namespace rpc
+} //namespace tree
+
+#endif //NEOVIM_CPP__DISPATCH_HPP
@@ -4,6 +4,20 @@
 
 namespace nvim {
 
+namespace {
+// Pre-encoded method names, see Method.
+{%- for func in functions %}
+constexpr Method {{func.const_name}}{"{{func.name}}", {{func.packed}}, {{func.packed_size}}};
+{%- endfor %}
+
+// Response decoders, one per return type, see Decoder.
+{%- for dec in decoders %}
+void {{dec.name}}(const msgpack::object &obj, {{dec.type}} &res) {
+    {{dec.body}}
+}
+{%- endfor %}
+}
+
 void Nvim::connect_tcp(const std::string &host,
         const std::string &service, double timeout_sec) {
     client_.connect_tcp(host, service, timeout_sec);
@@ -14,21 +28,53 @@ void Nvim::connect_pipe(const std::string &name,
     client_.connect_pipe(name, timeout_sec);
 }
 
+void Nvim::connect_stdio() {
+    client_.connect_stdio();
+}
+
+void Nvim::connect_fd(int fd) {
+    client_.connect_fd(fd);
+}
+
+Nvim::Batch Nvim::batch() {
+    return Batch(&client_);
+}
+
 {% for func in functions %}
 {{func.return}} Nvim::{{func.short_name}}({% for arg in func.args %}{{arg.type}} {{arg.name}}{% if not loop.last %}, {% endif %}{% endfor %}) {
     {%- if func.return != "void" %}
-    {{func.return}} res;
-    client_.call("{{func.name}}", res{% for arg in func.args %}, {{arg.name}}{% endfor %});
+    {{func.return}} res{};
+    client_.call({{func.const_name}}, res, {{func.decoder}}{% for arg in func.args %}, {{arg.name}}{% endfor %});
     return res;
     {%- else %}
-    client_.call("{{func.name}}", nullptr{% for arg in func.args %}, {{arg.name}}{% endfor %});
+    client_.call({{func.const_name}}, nullptr{% for arg in func.args %}, {{arg.name}}{% endfor %});
     {%- endif %}
 }
 {% endfor %}
 
 {% for func in functions %}
 void Nvim::async_{{func.short_name}}({% for arg in func.args %}{{arg.type}} {{arg.name}}{% if not loop.last %}, {% endif %}{% endfor %}) {
-    client_.async_call("{{func.name}}"{% for arg in func.args %}, {{arg.name}}{% endfor %});
+    client_.async_call({{func.const_name}}{% for arg in func.args %}, {{arg.name}}{% endfor %});
+}
+{% endfor %}
+
+{% for func in functions %}
+Future<{{func.return}}> Nvim::future_{{func.short_name}}({% for arg in func.args %}{{arg.type}} {{arg.name}}{% if not loop.last %}, {% endif %}{% endfor %}) {
+    {%- if func.return != "void" %}
+    return client_.future_call({{func.const_name}}, {{func.decoder}}{% for arg in func.args %}, {{arg.name}}{% endfor %});
+    {%- else %}
+    return client_.future_call({{func.const_name}}, nullptr{% for arg in func.args %}, {{arg.name}}{% endfor %});
+    {%- endif %}
+}
+{% endfor %}
+
+{% for func in functions %}
+BatchItem<{{func.return}}> Nvim::Batch::{{func.short_name}}({% for arg in func.args %}{{arg.type}} {{arg.name}}{% if not loop.last %}, {% endif %}{% endfor %}) {
+    {%- if func.return != "void" %}
+    return BatchItem<{{func.return}}>(add({{func.const_name}}{% for arg in func.args %}, {{arg.name}}{% endfor %}), {{func.decoder}});
+    {%- else %}
+    return BatchItem<void>(add({{func.const_name}}{% for arg in func.args %}, {{arg.name}}{% endfor %}));
+    {%- endif %}
 }
 {% endfor %}
 } //namespace nvim
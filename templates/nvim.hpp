@@ -9,10 +9,25 @@ namespace nvim {
 
 class Nvim {
 public:
+    /// Typed calls recorded for one nvim_call_atomic request.
+    class Batch : public BatchBase {
+    public:
+        explicit Batch(NvimRPC *client) : BatchBase(client) {}
+{% for func in functions %}
+        BatchItem<{{func.return}}> {{func.short_name}}({% for arg in func.args %}{{arg.type}} {{arg.name}}{% if not loop.last %}, {% endif %}{% endfor %});
+{%- endfor %}
+    };
+
+    Batch batch();
+
     void connect_tcp(const std::string &host,
             const std::string &service, double timeout_sec = 1.0);
     void connect_pipe(const std::string &name,
             double timeout_sec = 1.0);
+    /// Server started by nvim with jobstart(cmd, {'rpc': v:true}).
+    void connect_stdio();
+    /// A connection accepted by the daemon.
+    void connect_fd(int fd);
 
 {% for func in functions %}
     {{func.return}} {{func.short_name}}({% for arg in func.args %}{{arg.type}} {{arg.name}}{% if not loop.last %}, {% endif %}{% endfor %});
@@ -22,7 +37,11 @@ public:
     void async_{{func.short_name}}({% for arg in func.args %}{{arg.type}} {{arg.name}}{% if not loop.last %}, {% endif %}{% endfor %});
 {%- endfor %}
 
-private:
+{%- for func in functions %}
+    Future<{{func.return}}> future_{{func.short_name}}({% for arg in func.args %}{{arg.type}} {{arg.name}}{% if not loop.last %}, {% endif %}{% endfor %});
+{%- endfor %}
+
+public:
     NvimRPC client_;
 
 };